@@ -0,0 +1,177 @@
+#include "ConcurrentEvent.h"
+#include "Event.h"
+#include "EventChannel.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace
+{
+	constexpr int ListenerCount = 8;
+
+	struct Receiver
+	{
+		//Each thread only reads, so the listeners themselves don't become the point of contention.
+		int scale = 1;
+
+		void OnFire(int value) const
+		{
+			benchmark::DoNotOptimize(value * scale);
+		}
+	};
+
+	Receiver receivers[ListenerCount];
+
+	template<typename EventType>
+	EventType& MakeSharedEvent()
+	{
+		static EventType event;
+		static const bool bound = []()
+		{
+			for (auto& receiver : receivers)
+			{
+				event.Bind(&Receiver::OnFire, receiver);
+			}
+			return true;
+		}();
+		(void)bound;
+		return event;
+	}
+
+	/// What callers do without a thread-safe event: serialize every fire on a mutex.
+	void BM_MutexEventFire(benchmark::State& state)
+	{
+		static std::mutex mutex;
+		auto& event = MakeSharedEvent<Events::Event<int>>();
+		for (auto _ : state)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			event(1);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	void BM_ConcurrentEventFire(benchmark::State& state)
+	{
+		auto& event = MakeSharedEvent<Events::ConcurrentEvent<int>>();
+		for (auto _ : state)
+		{
+			event(1);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	void OnPosted(int, int value)
+	{
+		benchmark::DoNotOptimize(value);
+	}
+
+	///<summary>
+	///Thread that keeps delivering whatever the benchmark threads post, the way a main thread would, until Stop is called.
+	///</summary>
+	class Consumer
+	{
+	private:
+		std::atomic<bool> running{ true };
+		std::thread thread;
+
+	public:
+		template<typename DeliverType>
+		explicit Consumer(DeliverType Deliver) : thread([this, Deliver]()
+			{
+				while (running.load())
+				{
+					if (!Deliver())
+					{
+						std::this_thread::yield();
+					}
+				}
+				Deliver();
+			}) { }
+
+		void Stop()
+		{
+			running.store(false);
+			thread.join();
+		}
+	};
+
+	/// What callers do without a channel: a locked queue in front of an Event.
+	void BM_LockedQueuePost(benchmark::State& state)
+	{
+		static std::mutex mutex;
+		static std::deque<std::pair<int, int>> queue;
+		static Events::Event<int, int> event;
+		static Consumer* consumer = nullptr;
+		if (state.thread_index() == 0)
+		{
+			event.Bind(&OnPosted);
+			consumer = new Consumer([]()
+				{
+					std::deque<std::pair<int, int>> delivering;
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+						delivering.swap(queue);
+					}
+					for (auto& payload : delivering)
+					{
+						event(std::move(payload.first), std::move(payload.second));
+					}
+					return !delivering.empty();
+				});
+		}
+
+		for (auto _ : state)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			queue.emplace_back(state.thread_index(), 1);
+		}
+
+		//Every thread is done posting once the benchmark loop ends.
+		if (state.thread_index() == 0)
+		{
+			consumer->Stop();
+			delete consumer;
+			event.UnbindAll();
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	/// Same as BM_LockedQueuePost, posting through an EventChannel. Producers that find it full wait for the consumer.
+	void BM_ChannelPost(benchmark::State& state)
+	{
+		static Events::EventChannel<int, int> channel(1 << 16);
+		static Consumer* consumer = nullptr;
+		if (state.thread_index() == 0)
+		{
+			channel.Bind(&OnPosted);
+			consumer = new Consumer([]() { return channel.Dispatch() > 0; });
+		}
+
+		for (auto _ : state)
+		{
+			while (!channel(state.thread_index(), 1))
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		if (state.thread_index() == 0)
+		{
+			consumer->Stop();
+			delete consumer;
+			channel.UnbindAll();
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+}
+
+BENCHMARK(BM_MutexEventFire)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(BM_ConcurrentEventFire)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(BM_LockedQueuePost)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(BM_ChannelPost)->ThreadRange(1, 32)->UseRealTime();
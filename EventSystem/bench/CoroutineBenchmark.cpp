@@ -0,0 +1,136 @@
+#include "Event.h"
+
+#include <benchmark/benchmark.h>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+namespace
+{
+	/// Bare coroutine type, started right away and destroyed by its owner.
+	struct Script
+	{
+		struct promise_type
+		{
+			Script get_return_object()
+			{
+				return { std::coroutine_handle<promise_type>::from_promise(*this) };
+			}
+
+			std::suspend_never initial_suspend()
+			{
+				return {};
+			}
+
+			std::suspend_always final_suspend() noexcept
+			{
+				return {};
+			}
+
+			void return_void() { }
+
+			void unhandled_exception()
+			{
+				std::terminate();
+			}
+		};
+
+		std::coroutine_handle<promise_type> handle;
+	};
+
+	Script WaitForever(Events::Event<int>& event, long long& total)
+	{
+		while (true)
+		{
+			total += co_await event.Next();
+		}
+	}
+
+	long long polledTotal = 0;
+
+	/// What scripts do without awaitable events: a function sets a flag, each script checks it once per frame.
+	struct PollingScript
+	{
+		bool fired = false;
+		int value = 0;
+
+		void OnFire(int firedValue)
+		{
+			fired = true;
+			value = firedValue;
+		}
+
+		void Poll()
+		{
+			if (fired)
+			{
+				fired = false;
+				polledTotal += value;
+			}
+		}
+	};
+
+	/// Frames the event waits between two fires, in both benchmarks.
+	constexpr std::int64_t FramesPerFire = 60;
+
+	/// One frame of range(0) coroutines waiting on an event that fires once every FramesPerFire frames.
+	void BM_AwaitNext(benchmark::State& state)
+	{
+		Events::Event<int> event;
+		long long total = 0;
+		std::vector<Script> scripts;
+		for (std::int64_t i = 0; i < state.range(0); ++i)
+		{
+			scripts.push_back(WaitForever(event, total));
+		}
+
+		std::int64_t frame = 0;
+		for (auto _ : state)
+		{
+			if (++frame % FramesPerFire == 0)
+			{
+				event(1);
+			}
+			benchmark::DoNotOptimize(total);
+		}
+
+		for (auto& script : scripts)
+		{
+			script.handle.destroy();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// Baseline for BM_AwaitNext: range(0) scripts polling the flag set by their function, every frame.
+	void BM_PollFlag(benchmark::State& state)
+	{
+		Events::Event<int> event;
+		std::vector<PollingScript> scripts(state.range(0));
+		for (auto& script : scripts)
+		{
+			event.Bind(&PollingScript::OnFire, script);
+		}
+
+		std::int64_t frame = 0;
+		for (auto _ : state)
+		{
+			if (++frame % FramesPerFire == 0)
+			{
+				event(1);
+			}
+			for (auto& script : scripts)
+			{
+				script.Poll();
+			}
+			benchmark::DoNotOptimize(polledTotal);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+}
+
+BENCHMARK(BM_AwaitNext)->Arg(1)->Arg(64)->Arg(4096);
+BENCHMARK(BM_PollFlag)->Arg(1)->Arg(64)->Arg(4096);
+#endif
@@ -0,0 +1,234 @@
+#include "Event.h"
+#include "EventBus.h"
+#include "GroupedEvent.h"
+#include "StaticEvent.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	long long globalTotal = 0;
+
+	void OnGlobalFire(int value)
+	{
+		globalTotal += value;
+	}
+
+	struct Receiver
+	{
+		long long total = 0;
+
+		void OnFire(int value)
+		{
+			total += value;
+		}
+
+		void OnConstFire(int value) const
+		{
+			globalTotal += value;
+		}
+	};
+
+	/// Baseline: every wrapper in its own heap block, called through the vtable.
+	/// Wrapper kinds are interleaved like in a real event, otherwise the compiler speculatively devirtualizes the loop.
+	void BM_VirtualDispatch(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(state.range(0));
+		std::vector<std::unique_ptr<Events::FunctionWrapperBase<void, int>>> functions;
+		for (std::size_t i = 0; i < receivers.size(); ++i)
+		{
+			switch (i % 3)
+			{
+			case 0:
+				functions.emplace_back(std::make_unique<Events::RegularMemberFunctionWrapper<Receiver, void, int>>(&Receiver::OnFire, receivers[i]));
+				break;
+			case 1:
+				functions.emplace_back(std::make_unique<Events::ConstMemberFunctionWrapper<Receiver, void, int>>(&Receiver::OnConstFire, receivers[i]));
+				break;
+			default:
+				functions.emplace_back(std::make_unique<Events::GlobalFunctionWrapper<void, int>>(&OnGlobalFire));
+				break;
+			}
+		}
+
+		for (auto _ : state)
+		{
+			for (auto& function : functions)
+			{
+				(*function)(1);
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// Event: inline listener slots, called through the per-wrapper thunk.
+	void BM_EventDispatch(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(state.range(0));
+		Events::Event<int> event;
+		for (std::size_t i = 0; i < receivers.size(); ++i)
+		{
+			switch (i % 3)
+			{
+			case 0:
+				event.Bind(&Receiver::OnFire, receivers[i]);
+				break;
+			case 1:
+				event.Bind(&Receiver::OnConstFire, receivers[i]);
+				break;
+			default:
+				event.Bind(&OnGlobalFire);
+				break;
+			}
+		}
+
+		for (auto _ : state)
+		{
+			event(1);
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// StaticEvent: the same 8 listeners as BM_EventDispatch/8, fixed at compile time.
+	void BM_StaticEventDispatch(benchmark::State& state)
+	{
+		Receiver receivers[8];
+		Events::StaticEvent<&Receiver::OnFire, &Receiver::OnConstFire, &OnGlobalFire,
+			&Receiver::OnFire, &Receiver::OnConstFire, &OnGlobalFire,
+			&Receiver::OnFire, &Receiver::OnConstFire>
+			event(receivers[0], receivers[1], receivers[3], receivers[4], receivers[6], receivers[7]);
+
+		for (auto _ : state)
+		{
+			event(1);
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * event.Size());
+	}
+
+	/// Event where every receiver binds the same member function, each through a wrapper of its own.
+	void BM_SameMemberEventDispatch(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(state.range(0));
+		Events::Event<int> event;
+		for (auto& receiver : receivers)
+		{
+			event.Bind(&Receiver::OnFire, receiver);
+		}
+
+		for (auto _ : state)
+		{
+			event(1);
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// GroupedEvent: the same receivers in a single group, called in one loop with a direct call.
+	void BM_GroupedDispatch(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(state.range(0));
+		Events::GroupedEvent<int> event;
+		for (auto& receiver : receivers)
+		{
+			event.Bind<&Receiver::OnFire>(receiver);
+		}
+
+		for (auto _ : state)
+		{
+			event(1);
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void OnFireBatch(Events::CallerSpan<Receiver*> receivers, int value)
+	{
+		for (Receiver* receiver : receivers)
+		{
+			receiver->total += value;
+		}
+	}
+
+	/// GroupedEvent: the same receivers handed to a batch handler all at once.
+	void BM_GroupedBatchDispatch(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(state.range(0));
+		Events::GroupedEvent<int> event;
+		for (auto& receiver : receivers)
+		{
+			event.BindBatch<&OnFireBatch>(receiver);
+		}
+
+		for (auto _ : state)
+		{
+			event(1);
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// Distinct payload types, so the bus holds as many events as the string map below.
+	template<std::size_t Index>
+	struct BusPayload
+	{
+		int value;
+	};
+
+	constexpr std::size_t BusEventCount = 64;
+
+	template<std::size_t ...Indices>
+	void BindAll(Events::EventBus& bus, std::index_sequence<Indices...>)
+	{
+		(bus.Bind<BusPayload<Indices>>([](const BusPayload<Indices>& payload) { globalTotal += payload.value; }), ...);
+	}
+
+	/// Baseline: events found by name in a string-keyed map, hashing the name on every publish.
+	void BM_StringKeyedPublish(benchmark::State& state)
+	{
+		std::unordered_map<std::string, Events::Event<const BusPayload<0>&>> events;
+		for (std::size_t i = 0; i < BusEventCount; ++i)
+		{
+			events["Subsystem/Event" + std::to_string(i)].Bind([](const BusPayload<0>& payload) { globalTotal += payload.value; });
+		}
+		const std::string name = "Subsystem/Event" + std::to_string(BusEventCount / 2);
+
+		for (auto _ : state)
+		{
+			events.find(name)->second(BusPayload<0>{ 1 });
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	/// EventBus: the same amount of events, found by the dense index of their payload type.
+	void BM_BusPublish(benchmark::State& state)
+	{
+		Events::EventBus bus;
+		BindAll(bus, std::make_index_sequence<BusEventCount>());
+
+		for (auto _ : state)
+		{
+			bus.Publish<BusPayload<BusEventCount / 2>>(1);
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+}
+
+BENCHMARK(BM_VirtualDispatch)->Arg(1)->Arg(8)->Arg(64)->Arg(4096);
+BENCHMARK(BM_EventDispatch)->Arg(1)->Arg(8)->Arg(64)->Arg(4096);
+BENCHMARK(BM_StaticEventDispatch);
+BENCHMARK(BM_SameMemberEventDispatch)->Arg(64)->Arg(4096);
+BENCHMARK(BM_GroupedDispatch)->Arg(64)->Arg(4096);
+BENCHMARK(BM_GroupedBatchDispatch)->Arg(64)->Arg(4096);
+BENCHMARK(BM_StringKeyedPublish);
+BENCHMARK(BM_BusPublish);
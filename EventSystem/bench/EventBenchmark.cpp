@@ -0,0 +1,822 @@
+#include "CoalescingEvent.h"
+#include "CacheAligned.h"
+#include "Event.h"
+#include "EventRecorder.h"
+#include "InlineEvent.h"
+#include "KeyedEvent.h"
+#include "PayloadPool.h"
+#include "QueuedEvent.h"
+#include "ReducingEvent.h"
+#include "ThreadPool.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace
+{
+	enum class ListenerKind
+	{
+		Global,
+		Member,
+		ConstMember,
+		/// Lambda capturing the receiver, stored in the listener slot.
+		Lambda,
+		/// The workaround Lambda replaces: a std::function on a helper object, bound as a member function.
+		StdFunction
+	};
+
+	long long globalTotal = 0;
+
+	template<typename PayloadType>
+	void OnGlobalFire(PayloadType value)
+	{
+		globalTotal += static_cast<long long>(value);
+	}
+
+	struct Receiver
+	{
+		long long total = 0;
+
+		template<typename PayloadType>
+		void OnFire(PayloadType value)
+		{
+			total += static_cast<long long>(value);
+		}
+
+		template<typename PayloadType>
+		void OnConstFire(PayloadType value) const
+		{
+			globalTotal += static_cast<long long>(value);
+		}
+
+		std::function<void(int)> function;
+
+		void OnFunctionFire(int value)
+		{
+			function(value);
+		}
+	};
+
+	/// Trivially copyable payload of the given size, converts to the value of its first byte.
+	template<std::size_t Size>
+	struct Payload
+	{
+		std::array<unsigned char, Size> bytes{};
+
+		explicit operator long long() const
+		{
+			return bytes[0];
+		}
+	};
+
+	template<ListenerKind Kind, typename... Args>
+	Events::ListenerHandle BindListener(Events::Event<Args...>& event, Receiver& receiver)
+	{
+		if constexpr (Kind == ListenerKind::Global)
+		{
+			(void)receiver;
+			return event.Bind(&OnGlobalFire<Args...>);
+		}
+		else if constexpr (Kind == ListenerKind::Member)
+		{
+			return event.Bind(&Receiver::OnFire<Args...>, receiver);
+		}
+		else if constexpr (Kind == ListenerKind::ConstMember)
+		{
+			return event.Bind(&Receiver::OnConstFire<Args...>, receiver);
+		}
+		else if constexpr (Kind == ListenerKind::Lambda)
+		{
+			return event.Bind([&receiver](auto value) { receiver.total += static_cast<long long>(value); });
+		}
+		else
+		{
+			receiver.function = [&receiver](int value) { receiver.total += value; };
+			return event.Bind(&Receiver::OnFunctionFire, receiver);
+		}
+	}
+
+	/// Touches a buffer larger than the last level cache, so the next access to the event comes from memory.
+	void EvictCaches()
+	{
+		static std::vector<unsigned char> buffer(32 * 1024 * 1024);
+		for (std::size_t i = 0; i < buffer.size(); i += 64)
+		{
+			++buffer[i];
+		}
+		benchmark::ClobberMemory();
+	}
+
+	/// Binding range(0) functions into an empty event, including the growth of its storage.
+	template<ListenerKind Kind>
+	void BM_Bind(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(state.range(0));
+		for (auto _ : state)
+		{
+			Events::Event<int> event;
+			for (auto& receiver : receivers)
+			{
+				benchmark::DoNotOptimize(BindListener<Kind>(event, receiver));
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// Same as BM_Bind, with the storage reserved up front.
+	template<ListenerKind Kind>
+	void BM_BindReserved(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(state.range(0));
+		for (auto _ : state)
+		{
+			Events::Event<int> event;
+			event.Reserve(receivers.size());
+			for (auto& receiver : receivers)
+			{
+				benchmark::DoNotOptimize(BindListener<Kind>(event, receiver));
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// Binding range(0) functions with random priorities out of 8, so most of them get inserted in the middle of the event.
+	void BM_BindPriority(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(state.range(0));
+		std::vector<int> priorities(receivers.size());
+		std::mt19937 random(42);
+		for (int& priority : priorities)
+		{
+			priority = static_cast<int>(random() % 8);
+		}
+
+		for (auto _ : state)
+		{
+			Events::Event<int> event;
+			for (std::size_t i = 0; i < receivers.size(); ++i)
+			{
+				benchmark::DoNotOptimize(event.Bind(&Receiver::OnFire<int>, receivers[i], priorities[i]));
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// Unbinding each of range(0) functions through its handle, in random order.
+	void BM_UnbindHandle(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(state.range(0));
+		std::vector<Events::ListenerHandle> handles(receivers.size());
+		std::vector<std::size_t> order(receivers.size());
+		std::iota(order.begin(), order.end(), std::size_t(0));
+		std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+		for (auto _ : state)
+		{
+			state.PauseTiming();
+			Events::Event<int> event;
+			for (std::size_t i = 0; i < receivers.size(); ++i)
+			{
+				handles[i] = BindListener<ListenerKind::Member>(event, receivers[i]);
+			}
+			state.ResumeTiming();
+
+			for (std::size_t i : order)
+			{
+				event.Unbind(handles[i]);
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// Unbinding each of range(0) member functions by function and caller, in random order. Every call scans the event.
+	void BM_UnbindSignature(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(state.range(0));
+		std::vector<std::size_t> order(receivers.size());
+		std::iota(order.begin(), order.end(), std::size_t(0));
+		std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+		for (auto _ : state)
+		{
+			state.PauseTiming();
+			Events::Event<int> event;
+			for (auto& receiver : receivers)
+			{
+				BindListener<ListenerKind::Member>(event, receiver);
+			}
+			state.ResumeTiming();
+
+			for (std::size_t i : order)
+			{
+				event.Unbind(&Receiver::OnFire<int>, receivers[i]);
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// Binding range(0) objects in a single call, including the growth of the event's storage.
+	void BM_BindRange(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(state.range(0));
+		for (auto _ : state)
+		{
+			Events::Event<int> event;
+			event.BindRange(&Receiver::OnFire<int>, receivers.begin(), receivers.end());
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// Same as BM_UnbindSignature, unbinding every object in a single call.
+	void BM_UnbindRange(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(state.range(0));
+		std::vector<Receiver*> order(receivers.size());
+		std::iota(order.begin(), order.end(), receivers.data());
+		std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+		for (auto _ : state)
+		{
+			state.PauseTiming();
+			Events::Event<int> event;
+			event.BindRange(&Receiver::OnFire<int>, receivers.begin(), receivers.end());
+			state.ResumeTiming();
+
+			event.UnbindRange(&Receiver::OnFire<int>, order.begin(), order.end());
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// Firing an event with range(0) functions of a single kind, with everything already in cache.
+	template<ListenerKind Kind>
+	void BM_Fire(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(state.range(0));
+		Events::Event<int> event;
+		for (auto& receiver : receivers)
+		{
+			BindListener<Kind>(event, receiver);
+		}
+
+		for (auto _ : state)
+		{
+			event(1);
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// Firing range(0) separate events with a single function each, in random order, so most of them are cold.
+	template<typename EventType>
+	void BM_FireManyEvents(benchmark::State& state)
+	{
+		const std::size_t count = static_cast<std::size_t>(state.range(0));
+		std::unique_ptr<EventType[]> events(new EventType[count]);
+		std::vector<Receiver> receivers(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			BindListener<ListenerKind::Member>(events[i], receivers[i]);
+		}
+		std::vector<std::size_t> order(count);
+		std::iota(order.begin(), order.end(), std::size_t(0));
+		std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+		for (auto _ : state)
+		{
+			for (std::size_t i : order)
+			{
+				events[i](1);
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// Same as BM_Fire, with the caches flushed before every fire. The flush itself is not timed, but it is slow enough
+	/// that the iteration count has to be fixed, the benchmark would otherwise spend minutes reaching its minimum time.
+	template<ListenerKind Kind>
+	void BM_FireCold(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(state.range(0));
+		Events::Event<int> event;
+		for (auto& receiver : receivers)
+		{
+			BindListener<Kind>(event, receiver);
+		}
+
+		for (auto _ : state)
+		{
+			state.PauseTiming();
+			EvictCaches();
+			state.ResumeTiming();
+
+			event(1);
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// Firing 64 member functions with a payload of the given size, taken by value: every function but the last gets a copy.
+	template<std::size_t Size>
+	void BM_FirePayloadByValue(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(64);
+		Events::Event<Payload<Size>> event;
+		for (auto& receiver : receivers)
+		{
+			BindListener<ListenerKind::Member>(event, receiver);
+		}
+
+		Payload<Size> payload;
+		payload.bytes[0] = 1;
+		for (auto _ : state)
+		{
+			event(Payload<Size>(payload));
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * receivers.size());
+		state.SetBytesProcessed(state.iterations() * receivers.size() * Size);
+	}
+
+	/// Same as BM_FirePayloadByValue, taken by const reference: no function copies the payload.
+	template<std::size_t Size>
+	void BM_FirePayloadByReference(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(64);
+		Events::Event<const Payload<Size>&> event;
+		for (auto& receiver : receivers)
+		{
+			BindListener<ListenerKind::Member>(event, receiver);
+		}
+
+		Payload<Size> payload;
+		payload.bytes[0] = 1;
+		for (auto _ : state)
+		{
+			event(payload);
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * receivers.size());
+		state.SetBytesProcessed(state.iterations() * receivers.size() * Size);
+	}
+
+	struct InputReceiver
+	{
+		bool handles = false;
+
+		bool OnInput(int)
+		{
+			return handles;
+		}
+	};
+
+	/// Routing input through 256 functions where only the one at position range(0) handles it, so firing stops there.
+	void BM_ConsumableFire(benchmark::State& state)
+	{
+		std::vector<InputReceiver> receivers(256);
+		receivers[state.range(0)].handles = true;
+		Events::ConsumableEvent<int> event;
+		for (auto& receiver : receivers)
+		{
+			event.Bind(&InputReceiver::OnInput, receiver);
+		}
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(event(1));
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	struct Entity
+	{
+		int id = 0;
+		long long health = 0;
+
+		void OnDamage(int target, int amount)
+		{
+			if (target != id)
+			{
+				return;
+			}
+			health -= amount;
+		}
+
+		void OnOwnDamage(int, int amount)
+		{
+			health -= amount;
+		}
+	};
+
+	/// Baseline: range(0) entities all listening to the same event, each filtering out the damage dealt to the others.
+	void BM_FilteredFire(benchmark::State& state)
+	{
+		std::vector<Entity> entities(state.range(0));
+		Events::Event<int, int> event;
+		for (std::size_t i = 0; i < entities.size(); ++i)
+		{
+			entities[i].id = static_cast<int>(i);
+			event.Bind(&Entity::OnDamage, entities[i]);
+		}
+
+		int target = 0;
+		for (auto _ : state)
+		{
+			event(std::move(target), 1);
+			target = (target + 7) % static_cast<int>(entities.size());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	/// KeyedEvent: the same entities, each bound to its own id, so a fire only calls the one it's about.
+	void BM_KeyedFire(benchmark::State& state)
+	{
+		std::vector<Entity> entities(state.range(0));
+		Events::KeyedEvent<int, int> event;
+		for (std::size_t i = 0; i < entities.size(); ++i)
+		{
+			entities[i].id = static_cast<int>(i);
+			event.BindKeyed(entities[i].id, &Entity::OnOwnDamage, entities[i]);
+		}
+
+		int target = 0;
+		for (auto _ : state)
+		{
+			event(std::move(target), 1);
+			target = (target + 7) % static_cast<int>(entities.size());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	constexpr const char* RecordingPath = "EventBenchmark.evlg";
+
+	/// Firing to 8 listeners, with range(0) telling whether the fires are also recorded.
+	void BM_RecordedFire(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(8);
+		Events::Event<int> event;
+		for (auto& receiver : receivers)
+		{
+			BindListener<ListenerKind::Member>(event, receiver);
+		}
+
+		{
+			Events::EventRecorder recorder(RecordingPath);
+			Events::Subscription recording;
+			if (state.range(0) != 0)
+			{
+				recording = recorder.Record(event, 1);
+			}
+
+			int value = 0;
+			for (auto _ : state)
+			{
+				event(std::move(value));
+				++value;
+			}
+		}
+		std::remove(RecordingPath);
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	/// Playing back range(0) recorded fires into 8 listeners.
+	void BM_Playback(benchmark::State& state)
+	{
+		{
+			Events::Event<int> recorded;
+			Events::EventRecorder recorder(RecordingPath);
+			Events::Subscription recording = recorder.Record(recorded, 1);
+			for (int i = 0; i < state.range(0); ++i)
+			{
+				recorded(int(i));
+			}
+		}
+
+		std::vector<Receiver> receivers(8);
+		Events::Event<int> event;
+		for (auto& receiver : receivers)
+		{
+			BindListener<ListenerKind::Member>(event, receiver);
+		}
+		{
+			Events::EventPlayer player(RecordingPath);
+			player.Attach(1, event);
+			for (auto _ : state)
+			{
+				benchmark::DoNotOptimize(player.Play());
+			}
+		}
+		std::remove(RecordingPath);
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// Baseline: a signal fired range(0) times per frame, every value delivered to 16 listeners.
+	void BM_FrameOfSyncFires(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(16);
+		Events::Event<int> event;
+		for (auto& receiver : receivers)
+		{
+			BindListener<ListenerKind::Member>(event, receiver);
+		}
+
+		for (auto _ : state)
+		{
+			for (int i = 0; i < state.range(0); ++i)
+			{
+				event(std::move(i));
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// CoalescingEvent: the same fires, only the last one delivered when the frame flushes.
+	void BM_FrameOfCoalescedFires(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(16);
+		Events::CoalescingEvent<int> event;
+		for (auto& receiver : receivers)
+		{
+			event.Bind(&Receiver::OnFire<int>, receiver);
+		}
+
+		for (auto _ : state)
+		{
+			for (int i = 0; i < state.range(0); ++i)
+			{
+				event(std::move(i));
+			}
+			event.Dispatch();
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	using Packet = std::vector<std::uint8_t>;
+	constexpr std::size_t PacketSize = 1500;
+
+	struct PacketReceiver
+	{
+		long long total = 0;
+
+		void OnPacket(const Packet& packet)
+		{
+			total += packet[0];
+		}
+
+		void OnPooledPacket(const Events::PooledPayload<Packet>& packet)
+		{
+			total += (*packet)[0];
+		}
+	};
+
+	/// Baseline: range(0) packets queued per frame and delivered to 4 listeners, every packet copied into the queue.
+	void BM_QueuedPacketCopy(benchmark::State& state)
+	{
+		std::vector<PacketReceiver> receivers(4);
+		Events::QueuedEvent<const Packet&> event(state.range(0));
+		for (auto& receiver : receivers)
+		{
+			event.Bind(&PacketReceiver::OnPacket, receiver);
+		}
+		const Packet packet(PacketSize, 1);
+
+		for (auto _ : state)
+		{
+			for (int i = 0; i < state.range(0); ++i)
+			{
+				event(packet);
+			}
+			event.Dispatch();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// PayloadPool: the same packets taken from a pool, queued by handle and delivered by reference to it.
+	void BM_QueuedPooledPacket(benchmark::State& state)
+	{
+		std::vector<PacketReceiver> receivers(4);
+		Events::QueuedEvent<const Events::PooledPayload<Packet>&> event(state.range(0));
+		for (auto& receiver : receivers)
+		{
+			event.Bind(&PacketReceiver::OnPooledPacket, receiver);
+		}
+		Events::PayloadPool<Packet> pool(state.range(0), Packet(PacketSize, 1));
+
+		for (auto _ : state)
+		{
+			for (int i = 0; i < state.range(0); ++i)
+			{
+				event(pool.Acquire());
+			}
+			event.Dispatch();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	struct Modifier
+	{
+		int bonus = 1;
+
+		int GetBonus(int base) const
+		{
+			return base + bonus;
+		}
+
+		void CollectBonus(int base, std::vector<int>& results) const
+		{
+			results.push_back(base + bonus);
+		}
+	};
+
+	/// Summing the results of range(0) functions while firing.
+	void BM_ReducingFire(benchmark::State& state)
+	{
+		std::vector<Modifier> modifiers(state.range(0));
+		Events::ReducingEvent<Events::Sum<int>, int> event;
+		for (auto& modifier : modifiers)
+		{
+			event.Bind(&Modifier::GetBonus, modifier);
+		}
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(event(1));
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// Baseline for BM_ReducingFire: every function writes its result into an out-parameter vector, summed after the fire.
+	void BM_CollectThenSum(benchmark::State& state)
+	{
+		std::vector<Modifier> modifiers(state.range(0));
+		Events::Event<int, std::vector<int>&> event;
+		for (auto& modifier : modifiers)
+		{
+			event.Bind(&Modifier::CollectBonus, modifier);
+		}
+
+		for (auto _ : state)
+		{
+			std::vector<int> results;
+			event(1, results);
+			benchmark::DoNotOptimize(std::accumulate(results.begin(), results.end(), 0));
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// Stands in for a CPU-heavy, self-contained update, eg. the AI of a single entity.
+	struct Agent
+	{
+		float state = 1.0f;
+
+		void Update(float deltaTime)
+		{
+			float value = state;
+			for (int i = 0; i < 256; ++i)
+			{
+				value = value * 0.999f + deltaTime;
+			}
+			state = value;
+		}
+	};
+
+	/// Firing 4096 heavy functions on a pool of range(0) threads besides the calling one, 64 functions per chunk.
+	void BM_ParallelFire(benchmark::State& state)
+	{
+		std::vector<Agent> agents(4096);
+		Events::Event<float> event;
+		for (auto& agent : agents)
+		{
+			event.Bind(&Agent::Update, agent);
+		}
+
+		Events::ThreadPool pool(state.range(0));
+		for (auto _ : state)
+		{
+			event.FireParallel(pool, 64, 0.016f);
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * agents.size());
+	}
+
+	/// Creating range(0) events with 8 functions each, then destroying them all, like a scene being loaded and torn down.
+	void BM_EventLifetime(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(8);
+		for (auto _ : state)
+		{
+			std::vector<Events::Event<int>> events(state.range(0));
+			for (auto& event : events)
+			{
+				for (auto& receiver : receivers)
+				{
+					BindListener<ListenerKind::Member>(event, receiver);
+				}
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// Same as BM_EventLifetime, with every event allocating from one arena that is released all at once.
+	void BM_EventLifetimeArena(benchmark::State& state)
+	{
+		std::vector<Receiver> receivers(8);
+		std::pmr::monotonic_buffer_resource arena;
+		for (auto _ : state)
+		{
+			{
+				std::pmr::vector<Events::Event<int>> events(&arena);
+				events.reserve(state.range(0));
+				for (std::int64_t i = 0; i < state.range(0); ++i)
+				{
+					events.emplace_back(&arena);
+				}
+				for (auto& event : events)
+				{
+					for (auto& receiver : receivers)
+					{
+						BindListener<ListenerKind::Member>(event, receiver);
+					}
+				}
+				benchmark::ClobberMemory();
+			}
+			arena.release();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+}
+
+BENCHMARK_TEMPLATE(BM_Bind, ListenerKind::Global)->Arg(1)->Arg(64)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Bind, ListenerKind::Member)->Arg(1)->Arg(64)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Bind, ListenerKind::ConstMember)->Arg(1)->Arg(64)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Bind, ListenerKind::Lambda)->Arg(1)->Arg(64)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_BindReserved, ListenerKind::Member)->Arg(1)->Arg(64)->Arg(4096);
+BENCHMARK(BM_BindPriority)->Arg(64)->Arg(4096);
+
+BENCHMARK(BM_UnbindHandle)->Arg(64)->Arg(1024)->Arg(4096);
+BENCHMARK(BM_UnbindSignature)->Arg(64)->Arg(1024)->Arg(4096);
+BENCHMARK(BM_BindRange)->Arg(1)->Arg(64)->Arg(4096);
+BENCHMARK(BM_UnbindRange)->Arg(64)->Arg(1024)->Arg(4096);
+
+BENCHMARK_TEMPLATE(BM_Fire, ListenerKind::Global)->Arg(1)->Arg(8)->Arg(64)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Fire, ListenerKind::Member)->Arg(1)->Arg(8)->Arg(64)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Fire, ListenerKind::ConstMember)->Arg(1)->Arg(8)->Arg(64)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Fire, ListenerKind::Lambda)->Arg(1)->Arg(8)->Arg(64)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Fire, ListenerKind::StdFunction)->Arg(1)->Arg(8)->Arg(64)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_FireManyEvents, Events::Event<int>)->Arg(64)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_FireManyEvents, Events::InlineEvent<1, int>)->Arg(64)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_FireManyEvents, Events::CacheAligned<Events::InlineEvent<1, int>>)->Arg(64)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_FireCold, ListenerKind::Global)->Arg(1)->Arg(64)->Arg(4096)->Iterations(200);
+BENCHMARK_TEMPLATE(BM_FireCold, ListenerKind::Member)->Arg(1)->Arg(64)->Arg(4096)->Iterations(200);
+BENCHMARK_TEMPLATE(BM_FireCold, ListenerKind::ConstMember)->Arg(1)->Arg(64)->Arg(4096)->Iterations(200);
+
+BENCHMARK_TEMPLATE(BM_FirePayloadByValue, 8);
+BENCHMARK_TEMPLATE(BM_FirePayloadByValue, 64);
+BENCHMARK_TEMPLATE(BM_FirePayloadByValue, 512);
+BENCHMARK_TEMPLATE(BM_FirePayloadByValue, 4096);
+BENCHMARK_TEMPLATE(BM_FirePayloadByReference, 8);
+BENCHMARK_TEMPLATE(BM_FirePayloadByReference, 64);
+BENCHMARK_TEMPLATE(BM_FirePayloadByReference, 512);
+BENCHMARK_TEMPLATE(BM_FirePayloadByReference, 4096);
+
+BENCHMARK(BM_ConsumableFire)->Arg(0)->Arg(16)->Arg(255);
+
+BENCHMARK(BM_FrameOfSyncFires)->Arg(1)->Arg(100);
+BENCHMARK(BM_FrameOfCoalescedFires)->Arg(1)->Arg(100);
+
+BENCHMARK(BM_QueuedPacketCopy)->Arg(64);
+BENCHMARK(BM_QueuedPooledPacket)->Arg(64);
+
+BENCHMARK(BM_FilteredFire)->Arg(100)->Arg(10000);
+BENCHMARK(BM_KeyedFire)->Arg(100)->Arg(10000);
+
+BENCHMARK(BM_RecordedFire)->Arg(0)->Arg(1);
+BENCHMARK(BM_Playback)->Arg(100000);
+
+BENCHMARK(BM_ReducingFire)->Arg(8)->Arg(64);
+BENCHMARK(BM_CollectThenSum)->Arg(8)->Arg(64);
+
+BENCHMARK(BM_ParallelFire)->Arg(0)->Arg(1)->Arg(3)->Arg(7)->Arg(15)->Arg(31)->UseRealTime();
+
+BENCHMARK(BM_EventLifetime)->Arg(1000);
+BENCHMARK(BM_EventLifetimeArena)->Arg(1000);
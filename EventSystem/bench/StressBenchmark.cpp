@@ -0,0 +1,559 @@
+#include "ConcurrentEvent.h"
+#include "Event.h"
+#include "EventChannel.h"
+#include "QueuedEvent.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+//Stress and contention harness for the thread-safe and deferred events. Runs producers firing one event from several
+//threads, with listeners binding and unbinding others from inside the fire, and reports throughput, fire latency percentiles
+//and allocations per fire for each mode. It also checks every fire reached every listener bound for its whole duration,
+//and exits with 1 otherwise, so a build with EVENTSYSTEM_STRESS_TSAN doubles as a race detector run.
+
+namespace
+{
+	/// Every allocation made by the process, counted by the replaced global operator new below.
+	std::atomic<std::uint64_t> allocationCount{ 0 };
+}
+
+//The replaced operators must not be inlined: GCC would then see the malloc or free inside them paired with the other
+//operator at a new expression, and warn about mismatched allocation functions although both sides are replaced together.
+#if defined(_MSC_VER)
+#define STRESS_NOINLINE __declspec(noinline)
+#else
+#define STRESS_NOINLINE __attribute__((noinline))
+#endif
+
+STRESS_NOINLINE void* operator new(std::size_t size)
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	if (void* pointer = std::malloc(size > 0 ? size : 1))
+	{
+		return pointer;
+	}
+	throw std::bad_alloc();
+}
+
+STRESS_NOINLINE void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	const std::size_t align = static_cast<std::size_t>(alignment);
+#if defined(_WIN32)
+	void* pointer = _aligned_malloc(size > 0 ? size : 1, align);
+#else
+	//aligned_alloc wants a size that is a multiple of the alignment.
+	void* pointer = std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align);
+#endif
+	if (pointer != nullptr)
+	{
+		return pointer;
+	}
+	throw std::bad_alloc();
+}
+
+STRESS_NOINLINE void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+STRESS_NOINLINE void operator delete(void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+STRESS_NOINLINE void operator delete(void* pointer, std::align_val_t) noexcept
+{
+#if defined(_WIN32)
+	_aligned_free(pointer);
+#else
+	std::free(pointer);
+#endif
+}
+
+STRESS_NOINLINE void operator delete(void* pointer, std::size_t, std::align_val_t alignment) noexcept
+{
+	operator delete(pointer, alignment);
+}
+
+namespace
+{
+	std::int64_t Now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	struct Options
+	{
+		unsigned producers = 2;
+		/// Threads delivering the channel mode. The other modes deliver on the producers.
+		unsigned consumers = 1;
+		/// Functions bound for the whole run, checked to be called once per fire.
+		unsigned listeners = 8;
+		/// Every that many calls, a listener binds a function and unbinds the one it bound before. 0 turns churn off.
+		unsigned churn = 64;
+		unsigned milliseconds = 500;
+		std::string mode = "all";
+	};
+
+	///<summary>
+	///Latencies measured by a single thread. Keeps the latest Capacity ones, in memory taken before the run starts so that
+	///recording them never shows up in the allocation count.
+	///</summary>
+	class LatencySamples
+	{
+	private:
+		static constexpr std::size_t Capacity = 1 << 18;
+
+		std::vector<std::uint32_t> samples = std::vector<std::uint32_t>(Capacity);
+		std::size_t count = 0;
+
+	public:
+		void Add(std::int64_t nanoseconds)
+		{
+			samples[count++ % Capacity] = static_cast<std::uint32_t>(std::min<std::int64_t>(std::max<std::int64_t>(nanoseconds, 0), UINT32_MAX));
+		}
+
+		void AppendTo(std::vector<std::uint32_t>& all) const
+		{
+			all.insert(all.end(), samples.begin(), samples.begin() + std::min(count, Capacity));
+		}
+	};
+
+	/// Counters of the calling thread, read by each mode once the thread is done.
+	thread_local std::uint64_t stableCalls = 0;
+	thread_local std::uint64_t deliveredCount = 0;
+	thread_local std::uint64_t transientCalls = 0;
+	/// Where the calling thread records delivery latencies, for the modes that deliver later than they fire.
+	thread_local LatencySamples* deliveryLatencies = nullptr;
+
+	struct ThreadResult
+	{
+		LatencySamples latencies;
+		std::uint64_t fires = 0;
+	};
+
+	struct StableListener
+	{
+		void OnFire(std::int64_t) const
+		{
+			++stableCalls;
+		}
+	};
+
+	/// Bound last, records how long after being fired a payload was delivered.
+	struct DeliveryListener
+	{
+		void OnFire(std::int64_t firedAt) const
+		{
+			++deliveredCount;
+			if (deliveryLatencies != nullptr)
+			{
+				deliveryLatencies->Add(Now() - firedAt);
+			}
+		}
+	};
+
+	struct TransientListener
+	{
+		void OnFire(std::int64_t) const
+		{
+			++transientCalls;
+		}
+	};
+
+	TransientListener transient;
+
+	///<summary>
+	///Binds a function to its event every interval calls, and unbinds the one it bound before, all from inside the fire, the
+	///way a listener reacting to an event by adding or removing others would. Each thread keeps track of its own function.
+	///</summary>
+	template<typename EventType>
+	struct Churner
+	{
+		EventType* event;
+		unsigned interval;
+
+		void OnFire(std::int64_t) const
+		{
+			thread_local std::uint64_t calls = 0;
+			thread_local Events::ListenerHandle bound;
+			thread_local const EventType* boundTo = nullptr;
+			if (interval == 0 || ++calls % interval != 0)
+			{
+				return;
+			}
+
+			if (boundTo == event)
+			{
+				event->Unbind(bound);
+			}
+			bound = event->Bind(&TransientListener::OnFire, transient);
+			boundTo = event;
+		}
+	};
+
+	///<summary>
+	///Functions every mode binds to each of its events: the stable listeners, a churner, and the delivery listener if asked.
+	///</summary>
+	template<typename EventType>
+	struct Listeners
+	{
+		std::vector<StableListener> stable;
+		Churner<EventType> churner;
+		DeliveryListener delivery;
+
+		Listeners(EventType& event, const Options& options, bool trackDelivery) : stable(options.listeners), churner{ &event, options.churn }
+		{
+			for (auto& listener : stable)
+			{
+				event.Bind(&StableListener::OnFire, listener);
+			}
+			event.Bind(&Churner<EventType>::OnFire, churner);
+			if (trackDelivery)
+			{
+				event.Bind(&DeliveryListener::OnFire, delivery, INT_MIN);
+			}
+		}
+	};
+
+	///<summary>
+	///Starts and stops the threads of a run together, so that only the time between both, and the allocations made meanwhile,
+	///are measured.
+	///</summary>
+	struct Control
+	{
+		std::atomic<unsigned> ready{ 0 };
+		std::atomic<bool> started{ false };
+		std::atomic<bool> stopping{ false };
+		/// Producers that stopped firing, so consumers know when what's left to deliver is all there is.
+		std::atomic<unsigned> producersDone{ 0 };
+
+		/// Called by each thread once it's set up.
+		void WaitForStart()
+		{
+			ready.fetch_add(1);
+			while (!started.load())
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		bool Stopping() const
+		{
+			return stopping.load(std::memory_order_relaxed);
+		}
+	};
+
+	struct Report
+	{
+		const char* mode;
+		unsigned producers = 0;
+		unsigned consumers = 0;
+		std::uint64_t fires = 0;
+		double seconds = 0;
+		std::uint64_t allocations = 0;
+		std::vector<std::uint32_t> latencies;
+		bool valid = true;
+	};
+
+	///<summary>
+	///Runs the given body on threadCount threads for the configured time and measures them. The body gets its thread's index,
+	///result and the run's Control, and must call WaitForStart once set up, then run until Stopping.
+	///</summary>
+	template<typename BodyType>
+	Report Run(const Options& options, const char* mode, unsigned threadCount, BodyType&& Body)
+	{
+		Control control;
+		std::vector<std::unique_ptr<ThreadResult>> results;
+		for (unsigned i = 0; i < threadCount; ++i)
+		{
+			results.push_back(std::make_unique<ThreadResult>());
+		}
+
+		std::atomic<unsigned> finished{ 0 };
+		std::vector<std::thread> threads;
+		for (unsigned i = 0; i < threadCount; ++i)
+		{
+			threads.emplace_back([&, i]()
+				{
+					ThreadResult& result = *results[i];
+					deliveryLatencies = &result.latencies;
+					Body(i, result, control);
+					finished.fetch_add(1);
+				});
+		}
+
+		while (control.ready.load() < threadCount)
+		{
+			std::this_thread::yield();
+		}
+		const std::uint64_t allocationsBefore = allocationCount.load();
+		const std::int64_t startTime = Now();
+		control.started.store(true);
+		std::this_thread::sleep_for(std::chrono::milliseconds(options.milliseconds));
+		control.stopping.store(true);
+		while (finished.load() < threadCount)
+		{
+			std::this_thread::yield();
+		}
+		const std::int64_t endTime = Now();
+		const std::uint64_t allocationsAfter = allocationCount.load();
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		Report report;
+		report.mode = mode;
+		report.seconds = static_cast<double>(endTime - startTime) / 1e9;
+		report.allocations = allocationsAfter - allocationsBefore;
+		for (const auto& result : results)
+		{
+			report.fires += result->fires;
+			result->latencies.AppendTo(report.latencies);
+		}
+		return report;
+	}
+
+	std::uint64_t Sum(const std::vector<std::uint64_t>& values)
+	{
+		std::uint64_t total = 0;
+		for (std::uint64_t value : values)
+		{
+			total += value;
+		}
+		return total;
+	}
+
+	/// What callers do without a thread-safe event: every fire serialized on a mutex. Latency is the time spent firing.
+	Report RunMutex(const Options& options)
+	{
+		Events::Event<std::int64_t> event;
+		Listeners<Events::Event<std::int64_t>> listeners(event, options, false);
+		std::mutex mutex;
+		std::vector<std::uint64_t> calls(options.producers);
+
+		Report report = Run(options, "mutex", options.producers, [&](unsigned index, ThreadResult& result, Control& control)
+			{
+				control.WaitForStart();
+				while (!control.Stopping())
+				{
+					const std::int64_t start = Now();
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+						event(std::int64_t(start));
+					}
+					result.latencies.Add(Now() - start);
+					++result.fires;
+				}
+				calls[index] = stableCalls;
+			});
+		report.producers = options.producers;
+		report.valid = Sum(calls) == report.fires * options.listeners;
+		return report;
+	}
+
+	/// Every producer fires the same ConcurrentEvent. Latency is the time spent firing.
+	Report RunConcurrent(const Options& options)
+	{
+		Events::ConcurrentEvent<std::int64_t> event;
+		Listeners<Events::ConcurrentEvent<std::int64_t>> listeners(event, options, false);
+		std::vector<std::uint64_t> calls(options.producers);
+
+		Report report = Run(options, "concurrent", options.producers, [&](unsigned index, ThreadResult& result, Control& control)
+			{
+				control.WaitForStart();
+				while (!control.Stopping())
+				{
+					const std::int64_t start = Now();
+					event(std::int64_t(start));
+					result.latencies.Add(Now() - start);
+					++result.fires;
+				}
+				calls[index] = stableCalls;
+			});
+		report.producers = options.producers;
+		report.valid = Sum(calls) == report.fires * options.listeners;
+		return report;
+	}
+
+	///<summary>
+	///Producers post to one EventChannel per consumer, in turns, and each consumer delivers its own. Producers that find a
+	///channel full wait for it. Latency is the time from posting to delivery.
+	///</summary>
+	Report RunChannel(const Options& options)
+	{
+		using Channel = Events::EventChannel<std::int64_t>;
+		const unsigned consumers = std::max(options.consumers, 1u);
+		std::vector<std::unique_ptr<Channel>> channels;
+		for (unsigned i = 0; i < consumers; ++i)
+		{
+			channels.push_back(std::make_unique<Channel>(1 << 12));
+		}
+		std::vector<std::uint64_t> delivered(consumers);
+		std::vector<std::uint64_t> calls(consumers);
+
+		Report report = Run(options, "channel", options.producers + consumers, [&](unsigned index, ThreadResult& result, Control& control)
+			{
+				if (index < options.producers)
+				{
+					control.WaitForStart();
+					for (unsigned next = index % consumers; !control.Stopping(); next = (next + 1) % consumers)
+					{
+						while (!(*channels[next])(Now()))
+						{
+							std::this_thread::yield();
+						}
+						++result.fires;
+					}
+					control.producersDone.fetch_add(1);
+					return;
+				}
+
+				//Channels are bound to and delivered on the thread that owns them.
+				Channel& channel = *channels[index - options.producers];
+				Listeners<Channel> listeners(channel, options, true);
+				control.WaitForStart();
+				while (control.producersDone.load() < options.producers)
+				{
+					if (channel.Dispatch() == 0)
+					{
+						std::this_thread::yield();
+					}
+				}
+				while (channel.Dispatch() > 0)
+				{
+				}
+				delivered[index - options.producers] = deliveredCount;
+				calls[index - options.producers] = stableCalls;
+			});
+		report.producers = options.producers;
+		report.consumers = consumers;
+		report.valid = Sum(delivered) == report.fires && Sum(calls) == report.fires * options.listeners;
+		return report;
+	}
+
+	/// Every producer batches its fires in its own QueuedEvent and dispatches them. Latency is the time from firing to delivery.
+	Report RunQueued(const Options& options)
+	{
+		constexpr std::size_t BatchSize = 64;
+		std::vector<std::uint64_t> delivered(options.producers);
+		std::vector<std::uint64_t> calls(options.producers);
+
+		Report report = Run(options, "queued", options.producers, [&](unsigned index, ThreadResult& result, Control& control)
+			{
+				Events::QueuedEvent<std::int64_t> event(BatchSize);
+				Listeners<Events::QueuedEvent<std::int64_t>> listeners(event, options, true);
+				control.WaitForStart();
+				while (!control.Stopping())
+				{
+					for (std::size_t i = 0; i < BatchSize; ++i)
+					{
+						event(Now());
+					}
+					result.fires += BatchSize;
+					event.Dispatch();
+				}
+				delivered[index] = deliveredCount;
+				calls[index] = stableCalls;
+			});
+		report.producers = options.producers;
+		report.valid = Sum(delivered) == report.fires && Sum(calls) == report.fires * options.listeners;
+		return report;
+	}
+
+	std::uint32_t Percentile(const std::vector<std::uint32_t>& sorted, double fraction)
+	{
+		if (sorted.empty())
+		{
+			return 0;
+		}
+		return sorted[std::min(sorted.size() - 1, static_cast<std::size_t>(fraction * static_cast<double>(sorted.size())))];
+	}
+
+	void Print(Report& report)
+	{
+		std::sort(report.latencies.begin(), report.latencies.end());
+		const double fires = static_cast<double>(std::max<std::uint64_t>(report.fires, 1));
+		std::printf("%-11s %9u %9u %14.0f %9u %9u %9u %12.4f  %s\n", report.mode, report.producers, report.consumers,
+			static_cast<double>(report.fires) / report.seconds, Percentile(report.latencies, 0.5), Percentile(report.latencies, 0.99),
+			Percentile(report.latencies, 0.999), static_cast<double>(report.allocations) / fires, report.valid ? "ok" : "FAILED");
+	}
+
+	bool ParseOption(const char* argument, const char* name, unsigned& value)
+	{
+		const std::size_t length = std::strlen(name);
+		if (std::strncmp(argument, name, length) != 0 || argument[length] != '=')
+		{
+			return false;
+		}
+		value = static_cast<unsigned>(std::strtoul(argument + length + 1, nullptr, 10));
+		return true;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+	for (int i = 1; i < argc; ++i)
+	{
+		const char* argument = argv[i];
+		if (std::strncmp(argument, "--mode=", 7) == 0)
+		{
+			options.mode = argument + 7;
+		}
+		else if (!ParseOption(argument, "--producers", options.producers) && !ParseOption(argument, "--consumers", options.consumers) &&
+			!ParseOption(argument, "--listeners", options.listeners) && !ParseOption(argument, "--churn", options.churn) &&
+			!ParseOption(argument, "--milliseconds", options.milliseconds))
+		{
+			std::fprintf(stderr, "usage: %s [--mode=all|mutex|concurrent|channel|queued] [--producers=N] [--consumers=M]\n"
+				"       [--listeners=L] [--churn=K] [--milliseconds=T]\n", argv[0]);
+			return 2;
+		}
+	}
+	options.producers = std::max(options.producers, 1u);
+
+	struct Mode
+	{
+		const char* name;
+		Report(*run)(const Options&);
+	};
+	const Mode modes[] = { { "mutex", &RunMutex }, { "concurrent", &RunConcurrent }, { "channel", &RunChannel }, { "queued", &RunQueued } };
+
+	std::printf("%u listeners, churn every %u calls, %u ms per mode\n", options.listeners, options.churn, options.milliseconds);
+	std::printf("%-11s %9s %9s %14s %9s %9s %9s %12s  %s\n", "mode", "producers", "consumers", "fires/s", "p50 ns", "p99 ns", "p999 ns",
+		"allocs/fire", "check");
+	bool valid = true;
+	bool found = false;
+	for (const Mode& mode : modes)
+	{
+		if (options.mode == "all" || options.mode == mode.name)
+		{
+			found = true;
+			Report report = mode.run(options);
+			Print(report);
+			valid = valid && report.valid;
+		}
+	}
+
+	if (!found)
+	{
+		std::fprintf(stderr, "unknown mode %s\n", options.mode.c_str());
+		return 2;
+	}
+	return valid ? 0 : 1;
+}
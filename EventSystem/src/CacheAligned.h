@@ -0,0 +1,21 @@
+#pragma once
+#include <cstddef>
+
+namespace Events
+{
+	/// Size of a cache line on the targets this library is tuned for. Not std::hardware_destructive_interference_size, which
+	/// compilers warn may differ between builds, changing the layout of every type that uses it.
+	inline constexpr std::size_t CacheLineSize = 64;
+
+	///<summary>
+	///Event, or any other object, aligned on a cache line and padded to whole ones, so nothing next to it shares a line with it.
+	///Meant for arrays of events fired from different threads, eg. a std::array<CacheAligned<ConcurrentEvent<int>>, 8>, and for
+	///events declared next to counters other threads keep writing to. Takes the same constructor arguments as the wrapped type.
+	///</summary>
+	template<typename Type>
+	class alignas(CacheLineSize) CacheAligned : public Type
+	{
+	public:
+		using Type::Type;
+	};
+}
@@ -0,0 +1,168 @@
+#pragma once
+#include "DeferredEvent.h"
+
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Events
+{
+	///<summary>
+	///Deferred event that only keeps the latest arguments it was fired with: operator() overwrites whatever is pending, and
+	///Dispatch delivers that single payload, if any. Meant for signals that fire many times per frame, such as a position or a
+	///setting changing, whose listeners only care about where things ended up.
+	///Functions are bound and unbound just like on an Event, and always receive the stored copies, also for reference arguments.
+	///</summary>
+	template<typename... Args>
+	class CoalescingEvent : public DeferredEvent<Args...>
+	{
+	public:
+		using Payload = typename DeferredEvent<Args...>::Payload;
+
+	private:
+		std::optional<Payload> pending;
+
+	public:
+		CoalescingEvent() = default;
+
+		///<summary>
+		///Creates an event that takes all of its memory from the given resource, which must outlive the event.
+		///</summary>
+		explicit CoalescingEvent(std::pmr::memory_resource* resource) : DeferredEvent<Args...>(resource) { }
+
+		///<summary>
+		///Stores the given arguments in place of any pending ones, without calling anything.
+		///Returns whether it replaced arguments that were still pending.
+		///</summary>
+		bool operator() (Args&& ... args)
+		{
+			const bool replaced = pending.has_value();
+			pending.emplace(std::forward<Args>(args)...);
+			return replaced;
+		}
+
+		///<summary>
+		///Delivers the pending arguments, if any, and returns whether there were some. Arguments stored by the functions
+		///themselves wait for the next call.
+		///</summary>
+		bool Dispatch()
+		{
+			if (!pending)
+			{
+				return false;
+			}
+
+			//Taken out first, so functions that fire this event again store their arguments for the next call.
+			Payload payload(std::move(*pending));
+			pending.reset();
+			this->Deliver(payload);
+			return true;
+		}
+
+		void ClearPending()
+		{
+			pending.reset();
+		}
+
+		bool HasPending() const
+		{
+			return pending.has_value();
+		}
+	};
+
+	///<summary>
+	///Same as CoalescingEvent, keeping the latest arguments per key rather than overall, the key being the first argument.
+	///Eg. a KeyedCoalescingEvent<EntityId, Vector3> fired for many entities delivers one position per entity on Dispatch.
+	///Keys are delivered in the order they were first fired in since the last Dispatch.
+	///</summary>
+	template<typename... Args>
+	class KeyedCoalescingEvent : public DeferredEvent<Args...>
+	{
+		static_assert(sizeof...(Args) > 0, "The first argument of a KeyedCoalescingEvent is its key.");
+
+	public:
+		using Payload = typename DeferredEvent<Args...>::Payload;
+		using KeyType = std::tuple_element_t<0, Payload>;
+
+	private:
+		std::pmr::vector<Payload> pending;
+		/// Position of the pending payload of every key.
+		std::pmr::unordered_map<KeyType, std::size_t> positions;
+		/// Storage of the payloads being delivered, handed back to pending once done so flushing doesn't allocate.
+		std::pmr::vector<Payload> delivering;
+
+		template<typename FirstArg, typename ...OtherArgs>
+		static const FirstArg& KeyOf(const FirstArg& key, const OtherArgs& ...)
+		{
+			return key;
+		}
+
+	public:
+		KeyedCoalescingEvent() : KeyedCoalescingEvent(std::pmr::get_default_resource()) { }
+
+		///<summary>
+		///Creates an event that takes all of its memory from the given resource, which must outlive the event.
+		///</summary>
+		explicit KeyedCoalescingEvent(std::pmr::memory_resource* resource) :
+			DeferredEvent<Args...>(resource), pending(resource), positions(resource), delivering(resource) { }
+
+		///<summary>
+		///Stores the given arguments in place of any pending ones with the same key, without calling anything.
+		///Returns whether it replaced arguments that were still pending.
+		///</summary>
+		bool operator() (Args&& ... args)
+		{
+			const auto found = positions.try_emplace(KeyOf(args...), pending.size());
+			if (found.second)
+			{
+				pending.emplace_back(std::forward<Args>(args)...);
+				return false;
+			}
+
+			pending[found.first->second] = Payload(std::forward<Args>(args)...);
+			return true;
+		}
+
+		///<summary>
+		///Delivers the pending arguments of every key and returns how many keys had some. Arguments stored by the functions
+		///themselves wait for the next call.
+		///</summary>
+		std::size_t Dispatch()
+		{
+			if (pending.empty())
+			{
+				return 0;
+			}
+
+			//Taken out first, so functions that fire this event again store their arguments for the next call.
+			std::pmr::vector<Payload> payloads(std::move(delivering));
+			payloads.swap(pending);
+			positions.clear();
+			for (Payload& payload : payloads)
+			{
+				this->Deliver(payload);
+			}
+
+			const std::size_t count = payloads.size();
+			payloads.clear();
+			delivering = std::move(payloads);
+			return count;
+		}
+
+		void ClearPending()
+		{
+			pending.clear();
+			positions.clear();
+		}
+
+		std::size_t PendingCount() const
+		{
+			return pending.size();
+		}
+	};
+}
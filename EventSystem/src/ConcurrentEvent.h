@@ -0,0 +1,420 @@
+#pragma once
+#include "Event.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Events
+{
+	///<summary>
+	///Keeps track of the threads currently firing a ConcurrentEvent, so a replaced listener snapshot is only deleted once
+	///no thread can still be reading it. Readers only ever write to their own stripe; writers wait out a grace period instead.
+	///Readers never wait: snapshots retired while the retiring thread is itself firing are kept aside, and deleted by the
+	///next change any thread makes outside of a fire, or by an explicit call to Reclaim.
+	///</summary>
+	class SnapshotReaders
+	{
+	public:
+		static constexpr std::size_t StripeCount = 64;
+
+		/// Returned by Enter and handed back to Leave, so a reader leaves the same counter it entered.
+		using ReadToken = std::atomic<std::size_t>*;
+
+	private:
+		struct alignas(64) Stripe
+		{
+			std::atomic<std::size_t> readers[2] = { {0}, {0} };
+		};
+
+		struct RetiredSnapshot
+		{
+			const void* snapshot;
+			void(*destroy)(const void* snapshot);
+		};
+
+		Stripe stripes[StripeCount];
+		std::atomic<std::uint32_t> phase{ 0 };
+		std::mutex gracePeriodMutex;
+		/// Replaced snapshots that could still be in use, of every event. Guarded by retiredMutex.
+		std::vector<RetiredSnapshot> retired;
+		std::mutex retiredMutex;
+
+		static std::size_t& ThreadDepth()
+		{
+			thread_local std::size_t depth = 0;
+			return depth;
+		}
+
+		static std::size_t ThreadStripe()
+		{
+			static std::atomic<std::size_t> nextStripe{ 0 };
+			thread_local const std::size_t stripe = nextStripe.fetch_add(1, std::memory_order_relaxed) % StripeCount;
+			return stripe;
+		}
+
+		std::size_t CountReaders(std::uint32_t readerPhase) const
+		{
+			std::size_t count = 0;
+			for (const auto& stripe : stripes)
+			{
+				count += stripe.readers[readerPhase].load();
+			}
+			return count;
+		}
+
+	public:
+		ReadToken Enter()
+		{
+			++ThreadDepth();
+			ReadToken counter = &stripes[ThreadStripe()].readers[phase.load()];
+			counter->fetch_add(1);
+			return counter;
+		}
+
+		void Leave(ReadToken counter)
+		{
+			counter->fetch_sub(1);
+			--ThreadDepth();
+		}
+
+		/// Whether the calling thread is in the middle of firing a ConcurrentEvent.
+		bool IsReading() const
+		{
+			return ThreadDepth() > 0;
+		}
+
+		///<summary>
+		///Blocks until every reader that could have seen a snapshot replaced before this call is done with it.
+		///Must not be called while the calling thread is reading, it would be waiting on itself.
+		///</summary>
+		void WaitForReaders()
+		{
+			std::lock_guard<std::mutex> lock(gracePeriodMutex);
+			//Two flips: a reader may have loaded the phase right before the first one and only bumped its counter after it.
+			for (int flip = 0; flip < 2; ++flip)
+			{
+				const std::uint32_t oldPhase = phase.load();
+				phase.store(oldPhase ^ 1u);
+				while (CountReaders(oldPhase) != 0)
+				{
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		///<summary>
+		///Hands over a snapshot no event points to anymore, to be destroyed once no reader can still be using it.
+		///Destroys it right away, after a grace period, along with any other retired snapshot, unless the calling thread is
+		///reading: then it waits for the next call made outside of a fire.
+		///</summary>
+		void Retire(const void* snapshot, void(*destroy)(const void* snapshot))
+		{
+			{
+				std::lock_guard<std::mutex> lock(retiredMutex);
+				retired.push_back({ snapshot, destroy });
+			}
+
+			//A thread that is firing right now can't wait for readers, it would be waiting on itself.
+			if (!IsReading())
+			{
+				Reclaim();
+			}
+		}
+
+		///<summary>
+		///Destroys every retired snapshot after a grace period. Must not be called while the calling thread is reading.
+		///Only needed by programs whose events only ever change from inside their own fires, eg. once per frame.
+		///</summary>
+		void Reclaim()
+		{
+			std::vector<RetiredSnapshot> reclaimable;
+			{
+				std::lock_guard<std::mutex> lock(retiredMutex);
+				reclaimable.swap(retired);
+			}
+
+			//Waiting happens outside the lock, a reader may be retiring a snapshot from inside one of the functions.
+			if (!reclaimable.empty())
+			{
+				WaitForReaders();
+				for (const RetiredSnapshot& entry : reclaimable)
+				{
+					entry.destroy(entry.snapshot);
+				}
+			}
+		}
+	};
+
+	/// Shared by every ConcurrentEvent, so each event only costs a pointer to its snapshot.
+	inline SnapshotReaders snapshotReaders;
+
+	///<summary>
+	///Thread-safe counterpart of Event for events that are fired a lot more often than they change.
+	///Firing reads an immutable snapshot of the bound functions without taking any lock. Bind and Unbind copy the snapshot,
+	///change the copy and publish it, then free the old one once no thread is firing with it anymore.
+	///Binding or unbinding from inside one of the event's own functions is allowed, the old snapshot is freed by the next
+	///change made outside of a fire, see SnapshotReaders.
+	///Functions run from highest to lowest priority, and in bind order among equal priorities, same as with Event.
+	///</summary>
+	template<typename... Args>
+	class ConcurrentEvent
+	{
+	private:
+		struct Snapshot
+		{
+			std::vector<Listener<void, Args...>> functions;
+			/// Id handed out for each entry of functions, used as the index of its ListenerHandle.
+			std::vector<std::uint32_t> ids;
+			/// Priority each entry of functions was bound with. Never increases along the vector.
+			std::vector<int> priorities;
+		};
+
+		/// Keeps the calling thread registered as a reader for as long as it's alive.
+		struct ReadGuard
+		{
+			SnapshotReaders::ReadToken token = snapshotReaders.Enter();
+
+			~ReadGuard()
+			{
+				snapshotReaders.Leave(token);
+			}
+		};
+
+		std::atomic<const Snapshot*> current{ nullptr };
+		std::mutex writeMutex;
+		std::uint32_t nextId = 0;
+
+	private:
+		static void Destroy(const void* snapshot)
+		{
+			delete static_cast<const Snapshot*>(snapshot);
+		}
+
+		/// Copies the current snapshot, lets the given function change the copy and publishes the result.
+		template <typename ModifyType>
+		void Publish(ModifyType&& Modify)
+		{
+			const Snapshot* old;
+			{
+				std::lock_guard<std::mutex> lock(writeMutex);
+				old = current.load();
+				auto next = old != nullptr ? std::make_unique<Snapshot>(*old) : std::make_unique<Snapshot>();
+				Modify(*next);
+
+				current.store(next->functions.empty() ? nullptr : next.release());
+			}
+
+			//Retiring happens outside the lock, a reader may be blocked on it from inside one of the functions.
+			if (old != nullptr)
+			{
+				snapshotReaders.Retire(old, &Destroy);
+			}
+		}
+
+		template <typename WrapperType, typename ...WrapperArgs>
+		ListenerHandle BindWrapper(int priority, WrapperArgs&& ...wrapperArgs)
+		{
+			ListenerHandle handle;
+			Publish([&](Snapshot& snapshot)
+				{
+					if (nextId == ListenerHandle::InvalidIndex)
+					{
+						nextId = 0;
+					}
+					handle.index = nextId++;
+
+					//After every function of the same or a higher priority.
+					const std::size_t position = std::upper_bound(snapshot.priorities.begin(), snapshot.priorities.end(), priority,
+						std::greater<int>()) - snapshot.priorities.begin();
+					snapshot.functions.emplace(snapshot.functions.begin() + position, std::in_place_type<WrapperType>, std::forward<WrapperArgs>(wrapperArgs)...);
+					snapshot.ids.insert(snapshot.ids.begin() + position, handle.index);
+					snapshot.priorities.insert(snapshot.priorities.begin() + position, priority);
+				});
+			return handle;
+		}
+
+		/// <summary>
+		/// Unbinds functions of the given wrapper type that satisfy a given condition.
+		/// </summary>
+		template <typename FuncType, typename ConditionType>
+		void UnbindFunction(ConditionType&& ShouldRemove)
+		{
+			UnbindWhere([&](const Listener<void, Args...>& function, std::uint32_t)
+				{
+					auto func = function.GetWrapper()->template As<FuncType>();
+					return func != nullptr && ShouldRemove(func);
+				});
+		}
+
+		template <typename ConditionType>
+		void UnbindWhere(ConditionType&& ShouldRemove)
+		{
+			Publish([&](Snapshot& snapshot)
+				{
+					std::size_t kept = 0;
+					for (std::size_t i = 0; i < snapshot.functions.size(); ++i)
+					{
+						if (ShouldRemove(snapshot.functions[i], snapshot.ids[i]))
+						{
+							continue;
+						}
+
+						if (i != kept)
+						{
+							snapshot.functions[kept] = snapshot.functions[i];
+							snapshot.ids[kept] = snapshot.ids[i];
+							snapshot.priorities[kept] = snapshot.priorities[i];
+						}
+						++kept;
+					}
+					snapshot.functions.erase(snapshot.functions.begin() + kept, snapshot.functions.end());
+					snapshot.ids.resize(kept);
+					snapshot.priorities.resize(kept);
+				});
+		}
+
+	public:
+		ConcurrentEvent() = default;
+		ConcurrentEvent(const ConcurrentEvent&) = delete;
+		ConcurrentEvent& operator =(const ConcurrentEvent&) = delete;
+
+		///<summary>
+		///Must not run while another thread still changes this event, or starts firing it.
+		///Destroying the event from inside one of its own functions is allowed: the snapshot being fired outlives the event,
+		///so the remaining functions of that fire still run, and must not touch the event anymore.
+		///</summary>
+		~ConcurrentEvent()
+		{
+			const Snapshot* last = current.exchange(nullptr);
+			if (last != nullptr)
+			{
+				snapshotReaders.Retire(last, &Destroy);
+			}
+		}
+
+		///<summary>
+		///Calls every function of the current snapshot. Can run on any amount of threads at once, and never blocks.
+		///</summary>
+		void operator() (Args&& ... args)
+		{
+			ReadGuard guard;
+
+			const Snapshot* snapshot = current.load();
+			if (snapshot == nullptr)
+			{
+				return;
+			}
+
+			const auto& functions = snapshot->functions;
+			Listener<void, Args...>::CallAll(functions.data(), functions.data() + functions.size(), std::forward<Args>(args)...);
+		}
+
+		///<summary>
+		///Same as operator(), without ever moving from the given arguments. Every function taking a value argument gets its own copy.
+		///</summary>
+		void Broadcast(const Args& ... args)
+		{
+			ReadGuard guard;
+
+			const Snapshot* snapshot = current.load();
+			if (snapshot == nullptr)
+			{
+				return;
+			}
+
+			const auto& functions = snapshot->functions;
+			Listener<void, Args...>::CallAllConst(functions.data(), functions.data() + functions.size(), args...);
+		}
+
+		///<summary>
+		///Receives a member function from a given object and stores it in the list of functions attached to this event.
+		///Functions with a higher priority are called first. Returns a handle that can be passed to Unbind later on.
+		///</summary>
+		template <typename CallerType>
+		ListenerHandle Bind(void (CallerType::* funcPtr)(Args...), CallerType& caller, int priority = 0)
+		{
+			return BindWrapper<RegularMemberFunctionWrapper<CallerType, void, Args...>>(priority, funcPtr, caller);
+		}
+
+		///<summary>
+		///Receives a const member function from a given object and stores it in the list of functions attached to this event.
+		///Functions with a higher priority are called first. Returns a handle that can be passed to Unbind later on.
+		///</summary>
+		template <typename CallerType>
+		ListenerHandle Bind(void(CallerType::* funcPtr) (Args...) const, CallerType& caller, int priority = 0)
+		{
+			return BindWrapper<ConstMemberFunctionWrapper<CallerType, void, Args...>>(priority, funcPtr, caller);
+		}
+
+		///<summary>
+		///Receives a global function and stores it in the list of functions attached to this event.
+		///Functions with a higher priority are called first. Returns a handle that can be passed to Unbind later on.
+		///</summary>
+		ListenerHandle Bind(void(*funcPtr)(Args...), int priority = 0)
+		{
+			return BindWrapper<GlobalFunctionWrapper<void, Args...>>(priority, funcPtr);
+		}
+
+		///<summary>
+		///Removes the function identified by the given handle. Stale or invalid handles are ignored.
+		///</summary>
+		void Unbind(ListenerHandle handle)
+		{
+			UnbindWhere([&handle](const Listener<void, Args...>&, std::uint32_t id)
+				{ return id == handle.index; });
+		}
+
+		///<summary>
+		///Removes a global function from the list of functions attached to this event.
+		///</summary>
+		void Unbind(void(*funcPtr)(Args...))
+		{
+			UnbindFunction<GlobalFunctionWrapper<void, Args...>>
+				([funcPtr](GlobalFunctionWrapper<void, Args...>* v)
+					{ return (*v) == funcPtr; });
+		}
+
+		///<summary>
+		///Removes an object's member function from the list of functions attached to this event.
+		///</summary>
+		template <typename CallerType>
+		void Unbind(void (CallerType::* funcPtr)(Args...), CallerType& caller)
+		{
+			UnbindFunction<RegularMemberFunctionWrapper<CallerType, void, Args...>>
+				([funcPtr, &caller](RegularMemberFunctionWrapper<CallerType, void, Args...>* v)
+					{ return v->IsFunctionFromCaller(funcPtr, caller); });
+		}
+
+		///<summary>
+		///Removes an object's const member function from the list of functions attached to this event.
+		///</summary>
+		template <typename CallerType>
+		void Unbind(void(CallerType::* funcPtr) (Args...) const, CallerType& caller)
+		{
+			UnbindFunction<ConstMemberFunctionWrapper<CallerType, void, Args...>>
+				([funcPtr, &caller](ConstMemberFunctionWrapper<CallerType, void, Args...>* v)
+					{ return v->IsFunctionFromCaller(funcPtr, caller); });
+		}
+
+		///<summary>
+		///Removes every function from the list of functions attached to this event.
+		///</summary>
+		void UnbindAll()
+		{
+			Publish([](Snapshot& snapshot)
+				{
+					snapshot.functions.clear();
+					snapshot.ids.clear();
+					snapshot.priorities.clear();
+				});
+		}
+	};
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "Event.h"
+
+#include <cstddef>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Events
+{
+	///<summary>
+	///Base of the events that store what they're fired with and call their functions later, eg. QueuedEvent.
+	///Functions are bound and unbound just like on an Event, but the Event itself stays private: firing through an Event
+	///reference, Broadcast, FireParallel or co_await would all call them right away, skipping the deferred delivery.
+	///</summary>
+	template<typename... Args>
+	class DeferredEvent : private Event<Args...>
+	{
+	public:
+		using Payload = std::tuple<std::decay_t<Args>...>;
+
+		using Event<Args...>::GetMemoryResource;
+		using Event<Args...>::MemoryNeeded;
+		using Event<Args...>::Reserve;
+		using Event<Args...>::ReservePending;
+		using Event<Args...>::ShrinkToFit;
+		using Event<Args...>::ListenerCount;
+		using Event<Args...>::SetDebugName;
+		using Event<Args...>::GetDebugName;
+		using Event<Args...>::GetStats;
+		using Event<Args...>::GetListenerStats;
+		using Event<Args...>::ResetStats;
+		using Event<Args...>::Bind;
+		using Event<Args...>::Subscribe;
+		using Event<Args...>::Unbind;
+		using Event<Args...>::IsBound;
+		using Event<Args...>::BindRange;
+		using Event<Args...>::UnbindRange;
+		using Event<Args...>::UnbindAllFromCaller;
+		using Event<Args...>::UnbindAll;
+
+	protected:
+		DeferredEvent() = default;
+
+		explicit DeferredEvent(std::pmr::memory_resource* resource) : Event<Args...>(resource) { }
+
+		///<summary>
+		///Calls every bound function with the stored arguments, handed over as the event's argument types.
+		///</summary>
+		void Deliver(Payload& payload)
+		{
+			Deliver(payload, std::index_sequence_for<Args...>());
+		}
+
+	private:
+		template<std::size_t ...Indices>
+		void Deliver(Payload& payload, std::index_sequence<Indices...>)
+		{
+			Event<Args...>::operator()(static_cast<Args&&>(std::get<Indices>(payload))...);
+		}
+	};
+}
@@ -1,9 +1,48 @@
 #pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
 #include <memory>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include "CacheAligned.h"
+#include "Profiling.h"
+
 namespace Events
 {
+	///<summary>
+	///Whether every listener can get an intact copy of an event argument: lvalue references, and values that can be copied.
+	///</summary>
+	template<typename Arg>
+	inline constexpr bool IsRepeatable = std::is_lvalue_reference<Arg>::value || std::is_copy_constructible<std::decay_t<Arg>>::value;
+
+	///<summary>
+	///How an event argument is handed to a listener when more listeners still need it: value and rvalue reference arguments
+	///become a fresh copy, so no listener can move from the object the next one receives. Lvalue references are passed as they are.
+	///Move-only arguments can't be copied: every listener receives the same object, so only the last one should move from it.
+	///</summary>
+	template<typename Arg>
+	using RepeatableArg = std::conditional_t<!std::is_lvalue_reference<Arg>::value && IsRepeatable<Arg>,
+		std::remove_cv_t<std::remove_reference_t<Arg>>, Arg&&>;
+
+	///<summary>
+	///Gives every wrapper type a unique address to identify it by, so a wrapper can be matched to its type without RTTI.
+	///</summary>
+	template<typename WrapperType>
+	struct WrapperTypeTag
+	{
+		static constexpr char value = 0;
+	};
+
 	///<summary>
 	///Base class for every function wrapper in the system. 
 	///</summary>
@@ -11,8 +50,29 @@ namespace Events
 	class FunctionWrapperBase
 	{
 	public:
+		virtual ~FunctionWrapperBase() = default;
+
 		/// Execute function with given arguments
 		virtual ReturnType operator()(Args&& ...args) = 0;
+
+		/// Copy this wrapper into the given memory block, which must be big and aligned enough to hold it.
+		virtual FunctionWrapperBase* CloneInto(void* memory) const = 0;
+
+		/// Address of the WrapperTypeTag of the concrete wrapper type.
+		virtual const void* GetTypeTag() const = 0;
+
+		/// Object whose member function this wrapper calls, or nullptr for wrappers that aren't tied to an object.
+		virtual const void* GetCaller() const
+		{
+			return nullptr;
+		}
+
+		/// Cast to the given concrete wrapper type, or nullptr if this wrapper is of a different type.
+		template<typename WrapperType>
+		WrapperType* As()
+		{
+			return GetTypeTag() == &WrapperTypeTag<WrapperType>::value ? static_cast<WrapperType*>(this) : nullptr;
+		}
 	};
 
 	template<typename Signature, typename ReturnType, typename ...Args>
@@ -52,6 +112,16 @@ namespace Events
 		{
 			return FunctionWrapper<ReturnType(*)(Args...), ReturnType, Args...>::funcPtr == otherGlobalFunction.funcPtr;
 		}
+
+		FunctionWrapperBase<ReturnType, Args...>* CloneInto(void* memory) const override
+		{
+			return new (memory) GlobalFunctionWrapper(*this);
+		}
+
+		const void* GetTypeTag() const override
+		{
+			return &WrapperTypeTag<GlobalFunctionWrapper>::value;
+		}
 	};
 
 	///<summary>
@@ -77,6 +147,16 @@ namespace Events
 		{
 			return &caller == &possibleCaller; //just compare memory addresses
 		}
+
+		const void* GetCaller() const override
+		{
+			return &caller;
+		}
+
+		bool IsFunctionFromCaller(Signature function, CallerType& possibleCaller)
+		{
+			return FunctionWrapper<Signature, ReturnType, Args...>::IsFunction(function) && IsCaller(possibleCaller);
+		}
 	};
 
 	///<summary>
@@ -88,6 +168,16 @@ namespace Events
 	public:
 		RegularMemberFunctionWrapper(ReturnType(CallerType::* funcPtr)(Args...), CallerType& caller) :
 			MemberFunctionWrapper<ReturnType(CallerType::*)(Args...), CallerType, ReturnType, Args...>(funcPtr, caller) { }
+
+		FunctionWrapperBase<ReturnType, Args...>* CloneInto(void* memory) const override
+		{
+			return new (memory) RegularMemberFunctionWrapper(*this);
+		}
+
+		const void* GetTypeTag() const override
+		{
+			return &WrapperTypeTag<RegularMemberFunctionWrapper>::value;
+		}
 	};
 	
 	///<summary>
@@ -99,134 +189,1765 @@ namespace Events
 	public:
 		ConstMemberFunctionWrapper(ReturnType(CallerType::* funcPtr)(Args...) const, CallerType& caller) :
 			MemberFunctionWrapper<ReturnType(CallerType::*)(Args...) const, CallerType, ReturnType, Args...>(funcPtr, caller) {	}
-	};	
 
+		FunctionWrapperBase<ReturnType, Args...>* CloneInto(void* memory) const override
+		{
+			return new (memory) ConstMemberFunctionWrapper(*this);
+		}
 
-	/// <summary>
-	/// An event stores a vector of functions with no return value.
-	/// To bind a function to an event, said function must match the arguments required by the event.
-	/// Eg. for an Event<string, int>, any function that wishes to be bound to it must require
-	/// exclusively a string and an int parameters, in this exact order, and not return anything.
-	/// </summary>
-	template<typename... Args>
-	class Event
+		const void* GetTypeTag() const override
+		{
+			return &WrapperTypeTag<ConstMemberFunctionWrapper>::value;
+		}
+	};	
+
+	///<summary>
+	///Wrapper for lambdas and other function objects, stored by value right inside the wrapper.
+	///</summary>
+	template<typename CallableType, typename ReturnType, typename ...Args>
+	class CallableWrapper : public FunctionWrapperBase<ReturnType, Args...>
 	{
 	private:
-		std::vector<std::unique_ptr<FunctionWrapperBase<void, Args...>>> boundFunctions;
+		CallableType callable;
+	public:
+		template<typename FromType>
+		explicit CallableWrapper(FromType&& callable) : callable(std::forward<FromType>(callable)) { }
+
+		ReturnType operator()(Args&& ...args) override
+		{
+			if constexpr (std::is_void<ReturnType>::value)
+			{
+				callable(std::forward<Args>(args)...);
+			}
+			else
+			{
+				return callable(std::forward<Args>(args)...);
+			}
+		}
 
+		FunctionWrapperBase<ReturnType, Args...>* CloneInto(void* memory) const override
+		{
+			return new (memory) CallableWrapper(*this);
+		}
+
+		const void* GetTypeTag() const override
+		{
+			return &WrapperTypeTag<CallableWrapper>::value;
+		}
+	};
+
+	///<summary>
+	///Wrapper for function objects too big for a listener slot. The object itself lives in a single block taken from the event's
+	///memory resource, shared by the copies the event makes of its slots as it moves them around.
+	///</summary>
+	template<typename CallableType, typename ReturnType, typename ...Args>
+	class SharedCallableWrapper : public FunctionWrapperBase<ReturnType, Args...>
+	{
 	private:
+		std::shared_ptr<CallableType> callable;
+	public:
+		template<typename FromType>
+		SharedCallableWrapper(std::pmr::memory_resource* resource, FromType&& callable) :
+			callable(std::allocate_shared<CallableType>(std::pmr::polymorphic_allocator<CallableType>(resource), std::forward<FromType>(callable))) { }
 
-		/// <summary>
-		/// Unbinds functions that satisfy a given condition. Used internally when public Unbind methods are called to
-		/// locate said functions in the vector boundFunctions.
-		/// </summary>
-		/// <param name="ShouldRemove">Condition that a function must meet to be removed.</param>
-		template <typename FuncType, typename ConditionType>
-		inline void UnbindFunction(ConditionType&& ShouldRemove)
+		ReturnType operator()(Args&& ...args) override
 		{
-			for (int i = boundFunctions.size() - 1; i >= 0; --i)
+			if constexpr (std::is_void<ReturnType>::value)
 			{
-				auto func = dynamic_cast<FuncType*>(boundFunctions[i].get());
-				if (func != nullptr && ShouldRemove(func))
-				{
-					boundFunctions.erase(boundFunctions.begin() + i);
-				}
+				(*callable)(std::forward<Args>(args)...);
+			}
+			else
+			{
+				return (*callable)(std::forward<Args>(args)...);
 			}
 		}
 
+		FunctionWrapperBase<ReturnType, Args...>* CloneInto(void* memory) const override
+		{
+			return new (memory) SharedCallableWrapper(*this);
+		}
+
+		const void* GetTypeTag() const override
+		{
+			return &WrapperTypeTag<SharedCallableWrapper>::value;
+		}
+	};
+
+	///<summary>
+	///Fixed-size slot that stores a single function wrapper inline, so a bound function doesn't need an allocation of its own
+	///and every slot of an event sits in the same contiguous block of memory.
+	///</summary>
+	template<typename ReturnType, typename ...Args>
+	class Listener
+	{
+	public:
+		/// Room for the biggest built-in wrapper: a vtable pointer, a member function pointer and a caller reference.
+		static constexpr std::size_t StorageSize = 4 * sizeof(void*);
+
+	private:
+		/// Type-erased entry point generated for the stored wrapper type. Calling through it skips the wrapper's vtable.
+		ReturnType(*invoker)(void* storage, Args&& ...args);
+		FunctionWrapperBase<ReturnType, Args...>* wrapper;
+		/// Calling a wrapper may change its own state, but never which function the slot holds.
+		alignas(void*) mutable unsigned char storage[StorageSize];
+
+		template<typename WrapperType>
+		static ReturnType Invoke(void* storage, Args&& ...args)
+		{
+			//Qualified call, so the compiler jumps straight to the wrapper's operator() instead of going through the vtable.
+			return std::launder(static_cast<WrapperType*>(storage))->WrapperType::operator()(std::forward<Args>(args)...);
+		}
+
+		/// Invoker of a disabled slot, so callers can keep walking the slots without checking each one.
+		static ReturnType Unbound(void*, Args&& ...)
+		{
+			return ReturnType();
+		}
+
+		/// Calls the stored wrapper, timing the call when listeners are profiled.
+		template<typename ...CallArgs>
+		ReturnType Call(CallArgs&& ...args) const
+		{
+#if EVENTSYSTEM_PROFILE_LISTENERS
+			EVENTSYSTEM_PROFILE_LISTENER_ZONE();
+			ListenerTimer timer(this);
+#endif
+			return invoker(storage, std::forward<CallArgs>(args)...);
+		}
+
 	public:
-		~Event()
+		template<typename WrapperType, typename ...WrapperArgs>
+		explicit Listener(std::in_place_type_t<WrapperType>, WrapperArgs&& ...wrapperArgs) : invoker(&Invoke<WrapperType>)
 		{
-			UnbindAll();
+			static_assert(sizeof(WrapperType) <= StorageSize, "Wrapper does not fit in a listener slot.");
+			static_assert(alignof(WrapperType) <= alignof(void*), "Wrapper is over-aligned for a listener slot.");
+			wrapper = new (storage) WrapperType(std::forward<WrapperArgs>(wrapperArgs)...);
 		}
 
-		void operator() (Args&& ... args)
+		Listener(const Listener& other) : invoker(other.invoker), wrapper(other.wrapper->CloneInto(storage)) { }
+
+		Listener& operator =(const Listener& other)
 		{
-			for (auto& function : boundFunctions)
+			if (this != &other)
 			{
-				//Note to self: can't call the () operator directly like in the FunctionWrappers because the pointer is not the function itself.
-				//Must dereference it first, otherwise the compiler won't be happy and complain about a function receiving X amount of parameters not existing.
-				(*function)(std::forward<Args>(args)...);
+				wrapper->~FunctionWrapperBase();
+				invoker = other.invoker;
+				wrapper = other.wrapper->CloneInto(storage);
 			}
+			return *this;
 		}
 
-		//TODO: research how to go about creating a Bind method that works for both reference AND value parameters
+		~Listener()
+		{
+			wrapper->~FunctionWrapperBase();
+		}
 
-		///<summary>
-		///Receives a member function from a given object and stores it in the list of functions attached to this event.
-		///</summary>
-		template <typename CallerType>
-		void Bind(void (CallerType::* funcPtr)(Args...), CallerType& caller)
+		ReturnType operator()(Args&& ...args) const
 		{
-			boundFunctions.emplace_back(std::make_unique<RegularMemberFunctionWrapper<CallerType, void, Args...>>(funcPtr, caller));
+			return Call(std::forward<Args>(args)...);
 		}
 
-		///<summary>
-		///Receives a member function from a given object and stores it in the list of functions attached to this event.
-		///</summary>
-		template <typename CallerType>
-		void Bind(void (CallerType::* funcPtr)(Args&&...), CallerType& caller)
+		FunctionWrapperBase<ReturnType, Args...>* GetWrapper() const
 		{
-			boundFunctions.emplace_back(std::make_unique<RegularMemberFunctionWrapper<CallerType, void, Args...>>(funcPtr, caller));
+			return wrapper;
 		}
-		
+
+		/// Turns calls to this slot into no-ops. The wrapper itself is only destroyed along with the slot.
+		void Disable()
+		{
+			invoker = &Unbound;
+		}
+
+		bool IsEnabled() const
+		{
+			return invoker != &Unbound;
+		}
+
 		///<summary>
-		///Receives a const member function from a given object and stores it in the list of functions attached to this event.
+		///Calls every listener in [first, last). All but the last one receive copies of value arguments, the last one receives
+		///the arguments as they were passed in, so a single rvalue payload is handed off without any copies.
 		///</summary>
-		template <typename CallerType>
-		void Bind(void(CallerType::* funcPtr) (Args&&...) const, CallerType& caller)
+		static void CallAll(const Listener* first, const Listener* last, Args&& ...args)
 		{
-			boundFunctions.emplace_back(std::make_unique<ConstMemberFunctionWrapper<CallerType, void, Args...>>(funcPtr, caller));
+			if (first == last)
+			{
+				return;
+			}
+
+			for (--last; first != last; ++first)
+			{
+				first->Call(static_cast<RepeatableArg<Args>>(args)...);
+			}
+			last->Call(std::forward<Args>(args)...);
 		}
 
 		///<summary>
-		///Receives a global function and stores it in the list of functions attached to this event.
+		///Calls every enabled listener in [first, last) and folds their results into the given one, in order.
+		///Arguments are handed over like CallAll does. Disabled listeners are skipped, their default result would skew the fold.
 		///</summary>
-		void Bind(void(*funcPtr)(Args...))
+		template<typename ReducerType, typename ResultType>
+		static ResultType Reduce(const Listener* first, const Listener* last, ReducerType& Combine, ResultType result, Args&& ...args)
 		{
-			boundFunctions.emplace_back(std::make_unique<GlobalFunctionWrapper<void, Args...>>(funcPtr));
+			if (first == last)
+			{
+				return result;
+			}
+
+			for (--last; first != last; ++first)
+			{
+				if (first->IsEnabled())
+				{
+					Combine(result, first->Call(static_cast<RepeatableArg<Args>>(args)...));
+				}
+			}
+			if (last->IsEnabled())
+			{
+				Combine(result, last->Call(std::forward<Args>(args)...));
+			}
+			return result;
 		}
 
 		///<summary>
-		///Removes a global function from the list of functions attached to this event.
+		///Same as Reduce, without ever moving from the given arguments.
 		///</summary>
-		void Unbind(void(*funcPtr)(Args...))
+		template<typename ReducerType, typename ResultType>
+		static ResultType ReduceConst(const Listener* first, const Listener* last, ReducerType& Combine, ResultType result, const Args& ...args)
 		{
-			UnbindFunction<GlobalFunctionWrapper<void, Args...>>
-				([funcPtr](GlobalFunctionWrapper<void, Args...>* v)
-					{ return (*v) == funcPtr; });
+			static_assert((IsRepeatable<Args> && ...), "Firing without moving copies value arguments for every function, they must be copyable.");
+			for (; first != last; ++first)
+			{
+				if (first->IsEnabled())
+				{
+					Combine(result, first->Call(static_cast<RepeatableArg<Args>>(args)...));
+				}
+			}
+			return result;
 		}
 
 		///<summary>
-		///Removes an object's member function from the list of functions attached to this event.
+		///Calls listeners in [first, last) until one of them returns true, and returns whether one did. Arguments are handed over
+		///like CallAll does: the last listener receives them as they were passed in.
 		///</summary>
-		template <typename CallerType>
-		void Unbind(void (CallerType::* funcPtr)(Args...), CallerType& caller)
+		static bool CallUntilHandled(const Listener* first, const Listener* last, Args&& ...args)
 		{
-			UnbindFunction<MemberFunctionWrapper<CallerType, void, Args...>>
-				([funcPtr, &caller](MemberFunctionWrapper<CallerType, void, Args...>* v)
-					{ return v->IsFunctionFromCaller(funcPtr, caller); });
+			if (first == last)
+			{
+				return false;
+			}
+
+			for (--last; first != last; ++first)
+			{
+				if (first->Call(static_cast<RepeatableArg<Args>>(args)...))
+				{
+					return true;
+				}
+			}
+			return static_cast<bool>(last->Call(std::forward<Args>(args)...));
 		}
 
 		///<summary>
-		///Removes an object's const member function from the list of functions attached to this event.
+		///Same as CallUntilHandled, without ever moving from the given arguments.
 		///</summary>
-		template <typename CallerType>
-		void Unbind(void(CallerType::* funcPtr) (Args...) const, CallerType& caller)
+		static bool CallUntilHandledConst(const Listener* first, const Listener* last, const Args& ...args)
 		{
-			UnbindFunction<ConstMemberFunctionWrapper<CallerType, void, Args...>>
-				([funcPtr, &caller](ConstMemberFunctionWrapper<CallerType, void, Args...>* v)
-					{ return v->IsFunctionFromCaller(funcPtr, caller); });
+			static_assert((IsRepeatable<Args> && ...), "Firing without moving copies value arguments for every function, they must be copyable.");
+			for (; first != last; ++first)
+			{
+				if (first->Call(static_cast<RepeatableArg<Args>>(args)...))
+				{
+					return true;
+				}
+			}
+			return false;
 		}
-		
+
 		///<summary>
-		///Removes every function from the list of functions attached to this event.
+		///Calls every listener in [first, last) without ever moving from the given arguments.
+		///Listeners taking a value argument get their own copy, reference arguments are never copied.
 		///</summary>
-		void UnbindAll()
+		static void CallAllConst(const Listener* first, const Listener* last, const Args& ...args)
+		{
+			static_assert((IsRepeatable<Args> && ...), "Firing without moving copies value arguments for every function, they must be copyable.");
+			for (; first != last; ++first)
+			{
+				first->Call(static_cast<RepeatableArg<Args>>(args)...);
+			}
+		}
+	};
+
+	///<summary>
+	///Identifies a single function bound to an event. Returned by Bind and used to unbind that function in constant time.
+	///Once the function is unbound the handle goes stale and is ignored, even if its slot gets reused by a newer Bind.
+	///</summary>
+	struct ListenerHandle
+	{
+		static constexpr std::uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+		std::uint32_t index = InvalidIndex;
+		std::uint32_t generation = 0;
+
+		bool IsValid() const
+		{
+			return index != InvalidIndex;
+		}
+
+		bool operator ==(const ListenerHandle& other) const
 		{
-			boundFunctions.clear();
+			return index == other.index && generation == other.generation;
 		}
 
+		bool operator !=(const ListenerHandle& other) const
+		{
+			return !(*this == other);
+		}
+	};
+
+
+	///<summary>
+	///Node of an intrusive, circular doubly-linked list. Unlinking only needs the node itself.
+	///</summary>
+	struct IntrusiveLink
+	{
+		IntrusiveLink* previous = nullptr;
+		IntrusiveLink* next = nullptr;
+
+		bool IsLinked() const
+		{
+			return next != nullptr;
+		}
+
+		void Unlink()
+		{
+			if (next != nullptr)
+			{
+				previous->next = next;
+				next->previous = previous;
+				previous = nullptr;
+				next = nullptr;
+			}
+		}
+	};
+
+	///<summary>
+	///Intrusive list, whose nodes live in the objects it links, so linking never allocates.
+	///Copying a list gives an empty one, a node is only ever in a single list.
+	///</summary>
+	class IntrusiveList
+	{
+	private:
+		IntrusiveLink head;
+
+	public:
+		IntrusiveList()
+		{
+			head.previous = &head;
+			head.next = &head;
+		}
+
+		IntrusiveList(const IntrusiveList&) : IntrusiveList() { }
+
+		/// Takes every node of the given list, which is left empty.
+		IntrusiveList(IntrusiveList&& other) noexcept : IntrusiveList()
+		{
+			TakeAll(other);
+		}
+
+		IntrusiveList& operator =(const IntrusiveList&)
+		{
+			return *this;
+		}
+
+		/// Nodes still in the list are unlinked, which is how they can tell the list is gone.
+		~IntrusiveList()
+		{
+			while (!IsEmpty())
+			{
+				head.next->Unlink();
+			}
+		}
+
+		bool IsEmpty() const
+		{
+			return head.next == &head;
+		}
+
+		void PushBack(IntrusiveLink& link)
+		{
+			link.previous = head.previous;
+			link.next = &head;
+			head.previous->next = &link;
+			head.previous = &link;
+		}
+
+		/// Unlinks and returns the oldest node, or nullptr if there is none.
+		IntrusiveLink* PopFront()
+		{
+			if (IsEmpty())
+			{
+				return nullptr;
+			}
+
+			IntrusiveLink* link = head.next;
+			link->Unlink();
+			return link;
+		}
+
+		/// Calls the given function with every node, oldest first. The function must not link or unlink anything.
+		template<typename FunctionType>
+		void ForEach(FunctionType&& Function)
+		{
+			for (IntrusiveLink* link = head.next; link != &head; link = link->next)
+			{
+				Function(*link);
+			}
+		}
+
+		/// Moves every node of the given list to this one, which must be empty.
+		void TakeAll(IntrusiveList& other) noexcept
+		{
+			if (other.IsEmpty())
+			{
+				return;
+			}
+
+			head.next = other.head.next;
+			head.previous = other.head.previous;
+			head.next->previous = &head;
+			head.previous->next = &head;
+			other.head.next = &other.head;
+			other.head.previous = &other.head;
+		}
 	};
 
-}
\ No newline at end of file
+	template<typename ReturnType, typename... Args>
+	class BasicEvent;
+
+	///<summary>
+	///Keeps a function bound to an event for as long as it's alive, and unbinds it when destroyed. Returned by Subscribe.
+	///Safe to outlive its event: the event unlinks every subscription left when destroyed, and those then do nothing.
+	///</summary>
+	class Subscription : private IntrusiveLink
+	{
+		template<typename ReturnType, typename... Args>
+		friend class BasicEvent;
+
+	private:
+		void* event = nullptr;
+		void(*unbind)(void* event, ListenerHandle handle) = nullptr;
+		bool(*isBound)(const void* event, ListenerHandle handle) = nullptr;
+		ListenerHandle handle;
+
+		template<typename EventType>
+		static void Unbind(void* event, ListenerHandle handle)
+		{
+			static_cast<EventType*>(event)->Unbind(handle);
+		}
+
+		template<typename EventType>
+		static bool IsBound(const void* event, ListenerHandle handle)
+		{
+			return static_cast<const EventType*>(event)->IsBound(handle);
+		}
+
+		template<typename EventType>
+		Subscription(EventType& event, ListenerHandle handle, void(*unbind)(void* event, ListenerHandle handle)) :
+			event(&event), unbind(unbind), isBound(&IsBound<EventType>), handle(handle) { }
+
+		/// Takes the place of the given subscription in its event's list.
+		void TakeOver(Subscription& other) noexcept
+		{
+			event = other.event;
+			unbind = other.unbind;
+			isBound = other.isBound;
+			handle = other.handle;
+			if (other.IsLinked())
+			{
+				previous = other.previous;
+				next = other.next;
+				previous->next = this;
+				next->previous = this;
+				other.previous = nullptr;
+				other.next = nullptr;
+			}
+		}
+
+	public:
+		Subscription() = default;
+
+		Subscription(Subscription&& other) noexcept
+		{
+			TakeOver(other);
+		}
+
+		Subscription& operator =(Subscription&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Reset();
+				TakeOver(other);
+			}
+			return *this;
+		}
+
+		~Subscription()
+		{
+			Reset();
+		}
+
+		///<summary>
+		///Unbinds the function now, if its event still exists. Does nothing if it was already unbound some other way.
+		///</summary>
+		void Reset()
+		{
+			if (IsLinked())
+			{
+				Unlink();
+				unbind(event, handle);
+			}
+		}
+
+		///<summary>
+		///Lets go of the function without unbinding it, it stays bound until unbound some other way.
+		///</summary>
+		void Release()
+		{
+			Unlink();
+		}
+
+		///<summary>
+		///Whether the function is still bound to a living event.
+		///</summary>
+		bool IsActive() const
+		{
+			return IsLinked() && isBound(event, handle);
+		}
+
+		ListenerHandle GetHandle() const
+		{
+			return handle;
+		}
+	};
+
+	///<summary>
+	///Base class for objects whose member functions should unbind themselves when the object is destroyed.
+	///Binding a member function of a TrackedListener to an event also ties a Subscription to the object, nothing is
+	///checked while firing. Copies of an object start with no subscriptions of their own.
+	///</summary>
+	class TrackedListener
+	{
+	private:
+		std::vector<Subscription> subscriptions;
+		/// Size at which Track next drops the subscriptions whose function was unbound some other way.
+		std::size_t pruneSize = 8;
+
+	public:
+		TrackedListener() = default;
+
+		TrackedListener(const TrackedListener&) { }
+
+		TrackedListener& operator =(const TrackedListener&)
+		{
+			return *this;
+		}
+
+		///<summary>
+		///Ties the given subscription to this object, so it unbinds along with it.
+		///</summary>
+		void Track(Subscription&& subscription)
+		{
+			//Functions unbound some other way in the meantime shouldn't pile up. Pruning only once the vector doubled since
+			//the last time keeps binding many functions of one object linear.
+			if (subscriptions.size() >= pruneSize)
+			{
+				subscriptions.erase(std::remove_if(subscriptions.begin(), subscriptions.end(),
+					[](const Subscription& tracked) { return !tracked.IsActive(); }), subscriptions.end());
+				pruneSize = std::max<std::size_t>(8, 2 * subscriptions.size());
+			}
+			subscriptions.push_back(std::move(subscription));
+		}
+
+		///<summary>
+		///Unbinds every function tied to this object.
+		///</summary>
+		void UntrackAll()
+		{
+			subscriptions.clear();
+			pruneSize = 8;
+		}
+	};
+
+	/// <summary>
+	/// Stores the functions bound to an event, all taking the same arguments and returning the same type.
+	/// Holds everything but firing, which is up to each kind of event: Event calls every function, ConsumableEvent stops
+	/// at the first function that handles it.
+	/// Functions may bind and unbind functions of the event that is calling them. Unbound functions are skipped right away,
+	/// newly bound ones are only called starting with the next fire.
+	/// Functions run from highest to lowest priority, and in bind order among equal priorities. They are kept sorted as they
+	/// are bound, so firing never sorts anything.
+	/// Member functions of objects deriving from TrackedListener unbind automatically when their object is destroyed.
+	/// </summary>
+	template<typename ReturnType, typename... Args>
+	class BasicEvent
+	{
+	private:
+		///<summary>
+		///Maps a ListenerHandle to the current position of its function. Free entries chain to the next free one instead.
+		///</summary>
+		struct HandleSlot
+		{
+			std::uint32_t generation;
+			std::uint32_t position;
+		};
+
+		/// Marks a HandleSlot position as an index into pendingFunctions rather than boundFunctions.
+		static constexpr std::uint32_t PendingPosition = 0x80000000u;
+
+		///<summary>
+		///Tracks how deep in nested calls to operator() the event is, and adds pending functions once the outermost call ends.
+		///</summary>
+		struct DispatchScope
+		{
+			BasicEvent& event;
+
+			explicit DispatchScope(BasicEvent& event) : event(event)
+			{
+				++event.dispatchDepth;
+			}
+
+			~DispatchScope()
+			{
+				if (--event.dispatchDepth == 0 && event.hasPending)
+				{
+					event.AddPending();
+				}
+			}
+		};
+
+#if EVENTSYSTEM_PROFILING
+		///<summary>
+		///Adds the time spent in a single fire to the stats of the event, and points the calling thread's listener timers at the
+		///event while it lasts.
+		///</summary>
+		struct FireScope
+		{
+			BasicEvent& event;
+			ScopeTimer timer;
+#if EVENTSYSTEM_PROFILE_LISTENERS
+			ListenerRecorder recorder;
+			ListenerRecorder* previousRecorder = ListenerRecorder::Current();
+#endif
+
+			FireScope(BasicEvent& event, const Listener<ReturnType, Args...>* first, const Listener<ReturnType, Args...>* last) : event(event)
+			{
+				++event.stats.fireCount;
+				event.stats.listenerCount = static_cast<std::uint64_t>(last - first);
+#if EVENTSYSTEM_PROFILE_LISTENERS
+				recorder = { first, last, &event, &BasicEvent::RecordListener };
+				ListenerRecorder::Current() = &recorder;
+#endif
+			}
+
+			~FireScope()
+			{
+#if EVENTSYSTEM_PROFILE_LISTENERS
+				ListenerRecorder::Current() = previousRecorder;
+#endif
+				const std::uint64_t elapsed = timer.ElapsedNanoseconds();
+				event.stats.totalNanoseconds += elapsed;
+				event.stats.maxNanoseconds = std::max(event.stats.maxNanoseconds, elapsed);
+			}
+		};
+#endif
+
+		//Every container allocates from the memory resource given on construction.
+		//Everything a fire reads comes before pendingFunctions, so it all fits in the first cache line of the event.
+		std::pmr::vector<Listener<ReturnType, Args...>> boundFunctions;
+		/// Amount of disabled entries in boundFunctions still waiting to be removed.
+		std::uint32_t unboundCount = 0;
+		std::uint16_t dispatchDepth = 0;
+		/// Whether pendingFunctions holds anything, so the end of a fire doesn't have to look at it.
+		bool hasPending = false;
+		/// Whether coroutines may be waiting on the event, see HasWaiters.
+		bool hasWaiters = false;
+		/// Functions bound while the event was firing. boundFunctions must not grow or move while it's being walked.
+		std::pmr::vector<Listener<ReturnType, Args...>> pendingFunctions;
+		/// Handle slot owning each entry of boundFunctions, or InvalidIndex once that function was unbound.
+		std::pmr::vector<std::uint32_t> functionSlots;
+		/// Priority each entry of boundFunctions was bound with. Never increases along the vector.
+		std::pmr::vector<int> functionPriorities;
+		std::pmr::vector<std::uint32_t> pendingSlots;
+		std::pmr::vector<int> pendingPriorities;
+		std::pmr::vector<HandleSlot> handleSlots;
+		std::uint32_t freeSlot = ListenerHandle::InvalidIndex;
+		/// Amount of handle slots in use, ie. functions bound right now, pending ones included.
+		std::size_t liveSlots = 0;
+		/// Subscriptions handed out by this event, unlinked when it's destroyed so they know not to unbind anything.
+		IntrusiveList subscriptions;
+		/// What subscriptions handed out from now on call to unbind their function, see RouteSubscriptions.
+		void(*subscriptionUnbind)(void* event, ListenerHandle handle) = &Subscription::Unbind<BasicEvent>;
+		/// Shown by profilers. Not owned, so it must outlive the event.
+		const char* debugName = "Event";
+#if EVENTSYSTEM_PROFILING
+		EventStats stats;
+#endif
+#if EVENTSYSTEM_PROFILE_LISTENERS
+		/// Stats of the function owning each handle slot, cleared when the slot is released.
+		std::pmr::vector<ListenerStats> listenerStats;
+
+		static void RecordListener(void* event, const void* listener, std::uint64_t nanoseconds)
+		{
+			BasicEvent& self = *static_cast<BasicEvent*>(event);
+			const std::size_t position = static_cast<const Listener<ReturnType, Args...>*>(listener) - self.boundFunctions.data();
+			//A function that unbound itself while running has no stats left to add to.
+			const std::uint32_t slot = self.functionSlots[position];
+			if (slot != ListenerHandle::InvalidIndex)
+			{
+				ListenerStats& listenerStats = self.listenerStats[slot];
+				++listenerStats.callCount;
+				listenerStats.totalNanoseconds += nanoseconds;
+				listenerStats.maxNanoseconds = std::max(listenerStats.maxNanoseconds, nanoseconds);
+			}
+		}
+#endif
+
+	private:
+
+		/// <summary>
+		/// Unbinds functions that satisfy a given condition. Used internally when public Unbind methods are called to
+		/// locate said functions in the vector boundFunctions.
+		/// </summary>
+		/// <param name="ShouldRemove">Condition that a function must meet to be removed.</param>
+		/// Given FunctionWrapperBase as FuncType, the condition is checked against every function, whatever its type.
+		template <typename FuncType, typename ConditionType>
+		inline void UnbindFunction(ConditionType&& ShouldRemove)
+		{
+			for (std::size_t i = boundFunctions.size(); i-- > 0;)
+			{
+				if (functionSlots[i] == ListenerHandle::InvalidIndex)
+				{
+					continue;
+				}
+
+				auto func = WrapperAs<FuncType>(boundFunctions[i].GetWrapper());
+				if (func != nullptr && ShouldRemove(func))
+				{
+					UnbindAt(i);
+				}
+			}
+
+			for (std::size_t i = pendingFunctions.size(); i-- > 0;)
+			{
+				if (pendingSlots[i] == ListenerHandle::InvalidIndex)
+				{
+					continue;
+				}
+
+				auto func = WrapperAs<FuncType>(pendingFunctions[i].GetWrapper());
+				if (func != nullptr && ShouldRemove(func))
+				{
+					UnbindPendingAt(i);
+				}
+			}
+		}
+
+		template <typename FuncType>
+		static FuncType* WrapperAs(FunctionWrapperBase<ReturnType, Args...>* wrapper)
+		{
+			if constexpr (std::is_same<FuncType, FunctionWrapperBase<ReturnType, Args...>>::value)
+			{
+				return wrapper;
+			}
+			else
+			{
+				return wrapper->template As<FuncType>();
+			}
+		}
+
+		/// Lets a range of callers hold either objects or pointers to them.
+		template <typename CallerType>
+		static CallerType& CallerOf(CallerType& caller)
+		{
+			return caller;
+		}
+
+		template <typename CallerType>
+		static CallerType& CallerOf(CallerType* caller)
+		{
+			return *caller;
+		}
+
+		///<summary>
+		///Binds the same member function of every object in [first, last) with a single priority, appending them all at once:
+		///storage grows once, and the functions after their position, if any, are shifted and re-pointed once.
+		///</summary>
+		template <typename WrapperType, typename CallerType, typename FunctionType, typename CallerIterator>
+		void BindCallers(FunctionType funcPtr, CallerIterator first, CallerIterator last, int priority)
+		{
+			if (dispatchDepth > 0)
+			{
+				for (; first != last; ++first)
+				{
+					CallerType& caller = CallerOf<CallerType>(*first);
+					TrackCaller(caller, BindPending<WrapperType>(priority, funcPtr, caller));
+				}
+				return;
+			}
+
+			if (unboundCount > 0)
+			{
+				RemoveUnbound();
+			}
+
+			const std::size_t position = InsertPosition(priority);
+			const std::size_t end = boundFunctions.size();
+			if constexpr (std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<CallerIterator>::iterator_category>::value)
+			{
+				Reserve(end + static_cast<std::size_t>(std::distance(first, last)));
+			}
+
+			for (; first != last; ++first)
+			{
+				CallerType& caller = CallerOf<CallerType>(*first);
+				boundFunctions.emplace_back(std::in_place_type<WrapperType>, funcPtr, caller);
+				const std::uint32_t slot = AcquireSlot();
+				functionSlots.push_back(slot);
+				functionPriorities.push_back(priority);
+				TrackCaller(caller, ListenerHandle{ slot, handleSlots[slot].generation });
+			}
+
+			if (position != end)
+			{
+				std::rotate(boundFunctions.begin() + position, boundFunctions.begin() + end, boundFunctions.end());
+				std::rotate(functionSlots.begin() + position, functionSlots.begin() + end, functionSlots.end());
+				std::rotate(functionPriorities.begin() + position, functionPriorities.begin() + end, functionPriorities.end());
+			}
+			UpdatePositions(position);
+		}
+
+		/// Unbinds the given member function of every object in [first, last), in a single pass over the bound functions.
+		template <typename WrapperType, typename CallerType, typename FunctionType, typename CallerIterator>
+		void UnbindCallers(FunctionType funcPtr, CallerIterator first, CallerIterator last)
+		{
+			std::unordered_set<const void*> callers;
+			for (; first != last; ++first)
+			{
+				callers.insert(&CallerOf<CallerType>(*first));
+			}
+
+			UnbindFunction<WrapperType>([funcPtr, &callers](WrapperType* v)
+				{ return v->IsFunction(funcPtr) && callers.count(v->GetCaller()) != 0; });
+		}
+
+		Subscription MakeSubscription(ListenerHandle handle)
+		{
+			Subscription subscription(*this, handle, subscriptionUnbind);
+			subscriptions.PushBack(subscription);
+			return subscription;
+		}
+
+		/// Ties the function just bound to its caller, if the caller wants its functions to unbind along with it.
+		template <typename CallerType>
+		ListenerHandle TrackCaller(CallerType& caller, ListenerHandle handle)
+		{
+			if constexpr (std::is_base_of<TrackedListener, CallerType>::value)
+			{
+				static_cast<TrackedListener&>(caller).Track(MakeSubscription(handle));
+			}
+			return handle;
+		}
+
+		template <typename WrapperType, typename ...WrapperArgs>
+		ListenerHandle BindWrapper(int priority, WrapperArgs&& ...wrapperArgs)
+		{
+			if (dispatchDepth > 0)
+			{
+				return BindPending<WrapperType>(priority, std::forward<WrapperArgs>(wrapperArgs)...);
+			}
+
+			//Keeps disabled entries from piling up when functions are bound and unbound without the event ever firing,
+			//and from making the vector grow while they could make room instead, once there are enough to pay for the pass.
+			if (unboundCount > 0 && (unboundCount >= boundFunctions.size() / 2 ||
+				(boundFunctions.size() == boundFunctions.capacity() && unboundCount >= boundFunctions.size() / CompactionRatio)))
+			{
+				RemoveUnbound();
+			}
+
+			const std::size_t position = InsertPosition(priority);
+			boundFunctions.emplace(boundFunctions.begin() + position, std::in_place_type<WrapperType>, std::forward<WrapperArgs>(wrapperArgs)...);
+			const std::uint32_t slot = AcquireSlot();
+			functionSlots.insert(functionSlots.begin() + position, slot);
+			functionPriorities.insert(functionPriorities.begin() + position, priority);
+			UpdatePositions(position);
+			return { slot, handleSlots[slot].generation };
+		}
+
+		template <typename WrapperType, typename ...WrapperArgs>
+		ListenerHandle BindPending(int priority, WrapperArgs&& ...wrapperArgs)
+		{
+			pendingFunctions.emplace_back(std::in_place_type<WrapperType>, std::forward<WrapperArgs>(wrapperArgs)...);
+			hasPending = true;
+			const std::uint32_t slot = AcquireSlot();
+			handleSlots[slot].position = PendingPosition | static_cast<std::uint32_t>(pendingFunctions.size() - 1);
+			pendingSlots.push_back(slot);
+			pendingPriorities.push_back(priority);
+			return { slot, handleSlots[slot].generation };
+		}
+
+		/// Whether Bind stores the given type as a function object: anything callable with the event's arguments, except for plain
+		/// functions and function pointers, which have a Bind of their own.
+		template <typename CallableType>
+		struct IsBindableCallable : std::integral_constant<bool,
+			!std::is_function<std::remove_pointer_t<std::decay_t<CallableType>>>::value &&
+			!std::is_base_of<BasicEvent, std::decay_t<CallableType>>::value &&
+			std::is_copy_constructible<std::decay_t<CallableType>>::value &&
+			std::is_invocable_r<ReturnType, std::decay_t<CallableType>&, Args...>::value> { };
+
+		/// Bytes a vector of the given amount of elements takes from a memory resource, at worst.
+		template <typename ElementType>
+		static constexpr std::size_t ArrayBytes(std::size_t count)
+		{
+			return count * sizeof(ElementType) + alignof(ElementType) - 1;
+		}
+
+		/// Position a function of the given priority goes to: after every function of the same or a higher priority.
+		std::size_t InsertPosition(int priority) const
+		{
+			//Binding in priority order, or everything with the same priority, only ever appends.
+			if (functionPriorities.empty() || functionPriorities.back() >= priority)
+			{
+				return functionPriorities.size();
+			}
+			return std::upper_bound(functionPriorities.begin(), functionPriorities.end(), priority, std::greater<int>()) - functionPriorities.begin();
+		}
+
+		/// Points the handle slots of every function from the given position on back at their functions, after an insertion moved them.
+		void UpdatePositions(std::size_t first)
+		{
+			for (std::size_t i = first; i < functionSlots.size(); ++i)
+			{
+				if (functionSlots[i] != ListenerHandle::InvalidIndex)
+				{
+					handleSlots[functionSlots[i]].position = static_cast<std::uint32_t>(i);
+				}
+			}
+		}
+
+		std::uint32_t AcquireSlot()
+		{
+			std::uint32_t slot = freeSlot;
+			if (slot != ListenerHandle::InvalidIndex)
+			{
+				freeSlot = handleSlots[slot].position;
+			}
+			else
+			{
+				slot = static_cast<std::uint32_t>(handleSlots.size());
+				handleSlots.push_back({ 0, 0 });
+#if EVENTSYSTEM_PROFILE_LISTENERS
+				listenerStats.emplace_back();
+#endif
+			}
+			++liveSlots;
+			return slot;
+		}
+
+		/// Makes every handle to the given slot stale and puts the slot up for reuse.
+		void ReleaseSlot(std::uint32_t slot)
+		{
+			++handleSlots[slot].generation;
+			handleSlots[slot].position = freeSlot;
+			freeSlot = slot;
+			--liveSlots;
+#if EVENTSYSTEM_PROFILE_LISTENERS
+			listenerStats[slot] = ListenerStats();
+#endif
+		}
+
+		/// Disables the function at the given position and releases its handle slot. The entry itself is removed later by RemoveUnbound.
+		void UnbindAt(std::size_t position)
+		{
+			ReleaseSlot(functionSlots[position]);
+			boundFunctions[position].Disable();
+			functionSlots[position] = ListenerHandle::InvalidIndex;
+			++unboundCount;
+		}
+
+		/// Same as UnbindAt, for a function still waiting in pendingFunctions. AddPending skips it later.
+		void UnbindPendingAt(std::size_t position)
+		{
+			ReleaseSlot(pendingSlots[position]);
+			pendingSlots[position] = ListenerHandle::InvalidIndex;
+		}
+
+		/// Moves the functions bound during the last fire into boundFunctions, each at the position of its priority.
+		void AddPending()
+		{
+			//Functions unbound during the fire make room first, so adding the new ones doesn't grow the vector needlessly.
+			if (unboundCount > 0)
+			{
+				RemoveUnbound();
+			}
+
+			for (std::size_t i = 0; i < pendingFunctions.size(); ++i)
+			{
+				const std::uint32_t slot = pendingSlots[i];
+				if (slot == ListenerHandle::InvalidIndex)
+				{
+					continue;
+				}
+
+				const std::size_t position = InsertPosition(pendingPriorities[i]);
+				boundFunctions.insert(boundFunctions.begin() + position, pendingFunctions[i]);
+				functionSlots.insert(functionSlots.begin() + position, slot);
+				functionPriorities.insert(functionPriorities.begin() + position, pendingPriorities[i]);
+				UpdatePositions(position);
+			}
+
+			pendingFunctions.clear();
+			pendingSlots.clear();
+			pendingPriorities.clear();
+			hasPending = false;
+		}
+
+		/// Removes every disabled entry in a single pass, keeping the remaining functions in bind order.
+		void RemoveUnbound()
+		{
+			std::size_t kept = 0;
+			for (std::size_t i = 0; i < boundFunctions.size(); ++i)
+			{
+				if (functionSlots[i] == ListenerHandle::InvalidIndex)
+				{
+					continue;
+				}
+
+				if (i != kept)
+				{
+					boundFunctions[kept] = boundFunctions[i];
+					functionSlots[kept] = functionSlots[i];
+					functionPriorities[kept] = functionPriorities[i];
+					handleSlots[functionSlots[kept]].position = static_cast<std::uint32_t>(kept);
+				}
+				++kept;
+			}
+
+			boundFunctions.erase(boundFunctions.begin() + kept, boundFunctions.end());
+			functionSlots.resize(kept);
+			functionPriorities.resize(kept);
+			unboundCount = 0;
+		}
+
+	protected:
+		///<summary>
+		///A full event compacts instead of growing only once at least one in CompactionRatio of its entries is disabled, so
+		///unbinding and binding again in a loop stays amortized constant time instead of compacting on every bind.
+		///</summary>
+		static constexpr std::size_t CompactionRatio = 8;
+
+		///<summary>
+		///Runs the given call over every bound function, handing it the range of functions to walk, and returns its result.
+		///Takes care of what every kind of fire has to do around it: dropping unbound functions, and adding the ones bound
+		///during the call once it's over.
+		///</summary>
+		template <typename CallType>
+		decltype(auto) CallBound(CallType&& Call)
+		{
+			//Compacting here costs no more than the fire itself, and keeps Unbind constant time.
+			if (unboundCount > 0 && dispatchDepth == 0)
+			{
+				RemoveUnbound();
+			}
+
+			const Listener<ReturnType, Args...>* first = boundFunctions.data();
+			const Listener<ReturnType, Args...>* last = boundFunctions.data() + boundFunctions.size();
+			DispatchScope scope(*this);
+			EVENTSYSTEM_PROFILE_ZONE(debugName);
+#if EVENTSYSTEM_PROFILING
+			FireScope fire(*this, first, last);
+#endif
+			return Call(first, last);
+		}
+
+		///<summary>
+		///Makes the subscriptions this event hands out from now on, tracked callers included, unbind through the given function
+		///instead of Unbind. It gets this event as a BasicEvent, so an event owned by another one can let its owner know.
+		///</summary>
+		void RouteSubscriptions(void(*unbind)(void* event, ListenerHandle handle))
+		{
+			subscriptionUnbind = unbind;
+		}
+
+		///<summary>
+		///Makes room for functions bound while the event is firing, which wait aside until the fire is over.
+		///Along with Reserve, binding up to the given amount of functions never allocates, not even from inside a fire.
+		///</summary>
+		void ReservePending(std::size_t count)
+		{
+			pendingFunctions.reserve(count);
+			pendingSlots.reserve(count);
+			pendingPriorities.reserve(count);
+		}
+
+	protected:
+		///<summary>
+		///Creates an event that takes room for listenerCapacity bound functions from listenerResource right away, and everything
+		///else from resource. Lets a derived event keep its first functions inline, see InlineEvent.
+		///</summary>
+		BasicEvent(std::pmr::memory_resource* listenerResource, std::size_t listenerCapacity, std::pmr::memory_resource* resource) :
+			boundFunctions(listenerResource), pendingFunctions(resource), functionSlots(resource), functionPriorities(resource),
+			pendingSlots(resource), pendingPriorities(resource), handleSlots(resource)
+#if EVENTSYSTEM_PROFILE_LISTENERS
+			, listenerStats(resource)
+#endif
+		{
+			boundFunctions.reserve(listenerCapacity);
+		}
+
+		///<summary>
+		///Whether coroutines may be waiting on a derived event, eg. Event. Kept next to the bound functions, so a fire tells
+		///there are none without reading past the first cache line of the event.
+		///</summary>
+		bool HasWaiters() const
+		{
+			return hasWaiters;
+		}
+
+		void SetHasWaiters(bool value)
+		{
+			hasWaiters = value;
+		}
+
+	public:
+		BasicEvent() : BasicEvent(std::pmr::get_default_resource()) { }
+
+		///<summary>
+		///Creates an event that takes all of its memory from the given resource, which must outlive the event.
+		///Binding the functions of many events to a single std::pmr::monotonic_buffer_resource lets them all be freed at once,
+		///by releasing the resource after the events are destroyed.
+		///</summary>
+		explicit BasicEvent(std::pmr::memory_resource* resource) : BasicEvent(resource, 0, resource) { }
+
+		///<summary>
+		///Takes over the functions of the given event, along with their handles and subscriptions, which keep working with this
+		///event from then on. Leaves the given event without functions. Neither event may be firing.
+		///</summary>
+		BasicEvent(BasicEvent&& other) noexcept :
+			boundFunctions(std::move(other.boundFunctions)), unboundCount(std::exchange(other.unboundCount, 0)),
+			hasPending(std::exchange(other.hasPending, false)), hasWaiters(std::exchange(other.hasWaiters, false)),
+			pendingFunctions(std::move(other.pendingFunctions)), functionSlots(std::move(other.functionSlots)),
+			functionPriorities(std::move(other.functionPriorities)), pendingSlots(std::move(other.pendingSlots)),
+			pendingPriorities(std::move(other.pendingPriorities)), handleSlots(std::move(other.handleSlots)),
+			freeSlot(std::exchange(other.freeSlot, ListenerHandle::InvalidIndex)), liveSlots(std::exchange(other.liveSlots, 0)),
+			subscriptions(std::move(other.subscriptions)), subscriptionUnbind(other.subscriptionUnbind), debugName(other.debugName)
+#if EVENTSYSTEM_PROFILING
+			, stats(other.stats)
+#endif
+#if EVENTSYSTEM_PROFILE_LISTENERS
+			, listenerStats(std::move(other.listenerStats))
+#endif
+		{
+			subscriptions.ForEach([this](IntrusiveLink& link) { static_cast<Subscription&>(link).event = static_cast<void*>(this); });
+		}
+
+		/// Copying would leave the subscriptions and tracked callers of the functions behind with the original.
+		BasicEvent(const BasicEvent&) = delete;
+		BasicEvent& operator =(const BasicEvent&) = delete;
+
+		~BasicEvent()
+		{
+			static_assert(sizeof(boundFunctions) + sizeof(unboundCount) + sizeof(dispatchDepth) + sizeof(hasPending) +
+				sizeof(hasWaiters) <= CacheLineSize, "Everything a fire reads must fit in the first cache line of the event.");
+			UnbindAll();
+		}
+
+		std::pmr::memory_resource* GetMemoryResource() const
+		{
+			return functionSlots.get_allocator().resource();
+		}
+
+		///<summary>
+		///Bytes that Reserve and ReservePending take from the memory resource for the given amount of functions, alignment
+		///included. Enough to back an event that never binds more than that many functions with a fixed buffer.
+		///</summary>
+		static constexpr std::size_t MemoryNeeded(std::size_t count)
+		{
+			std::size_t bytes = 2 * ArrayBytes<Listener<ReturnType, Args...>>(count) + 2 * ArrayBytes<std::uint32_t>(count) +
+				2 * ArrayBytes<int>(count) + ArrayBytes<HandleSlot>(count);
+#if EVENTSYSTEM_PROFILE_LISTENERS
+			bytes += ArrayBytes<ListenerStats>(count);
+#endif
+			return bytes;
+		}
+
+		///<summary>
+		///Makes room for at least the given amount of functions, so binding up to that many doesn't allocate.
+		///</summary>
+		void Reserve(std::size_t count)
+		{
+			//Growing boundFunctions would move the functions that are being called right now.
+			if (dispatchDepth == 0)
+			{
+				boundFunctions.reserve(count);
+			}
+			functionSlots.reserve(count);
+			functionPriorities.reserve(count);
+			handleSlots.reserve(count);
+#if EVENTSYSTEM_PROFILE_LISTENERS
+			listenerStats.reserve(count);
+#endif
+		}
+
+		///<summary>
+		///Gives back the memory the event holds beyond what its bound functions need, eg. after UnbindAll.
+		///The functions being called are left where they are while the event is firing.
+		///</summary>
+		void ShrinkToFit()
+		{
+			if (dispatchDepth == 0)
+			{
+				if (unboundCount > 0)
+				{
+					RemoveUnbound();
+				}
+				boundFunctions.shrink_to_fit();
+				functionSlots.shrink_to_fit();
+				functionPriorities.shrink_to_fit();
+			}
+			pendingFunctions.shrink_to_fit();
+			pendingSlots.shrink_to_fit();
+			pendingPriorities.shrink_to_fit();
+			//Handle slots stay, stale handles must keep pointing at a slot with a newer generation.
+		}
+
+		///<summary>
+		///Amount of functions bound right now, including the ones bound during the fire in progress.
+		///</summary>
+		std::size_t ListenerCount() const
+		{
+			return liveSlots;
+		}
+
+		///<summary>
+		///Names the event in profiler zones. The name isn't copied, so it must outlive the event, eg. a string literal.
+		///</summary>
+		void SetDebugName(const char* name)
+		{
+			debugName = name;
+		}
+
+		const char* GetDebugName() const
+		{
+			return debugName;
+		}
+
+		///<summary>
+		///Fire counts and times recorded since the event was created or ResetStats was last called.
+		///Always zero unless EVENTSYSTEM_PROFILING is defined to 1, see Profiling.h.
+		///</summary>
+		EventStats GetStats() const
+		{
+#if EVENTSYSTEM_PROFILING
+			return stats;
+#else
+			return EventStats();
+#endif
+		}
+
+		///<summary>
+		///Call counts and times of the function identified by the given handle, recorded since it was bound or ResetStats was
+		///last called. Always zero unless EVENTSYSTEM_PROFILE_LISTENERS is defined to 1, or when the handle is stale.
+		///Functions are only timed on the thread that fires the event, so FireParallel only records the calls it runs itself.
+		///</summary>
+		ListenerStats GetListenerStats(ListenerHandle handle) const
+		{
+#if EVENTSYSTEM_PROFILE_LISTENERS
+			if (IsBound(handle))
+			{
+				return listenerStats[handle.index];
+			}
+#endif
+			(void)handle;
+			return ListenerStats();
+		}
+
+		void ResetStats()
+		{
+#if EVENTSYSTEM_PROFILING
+			stats = EventStats();
+#endif
+#if EVENTSYSTEM_PROFILE_LISTENERS
+			std::fill(listenerStats.begin(), listenerStats.end(), ListenerStats());
+#endif
+		}
+
+		//TODO: research how to go about creating a Bind method that works for both reference AND value parameters
+
+		///<summary>
+		///Receives a member function from a given object and stores it in the list of functions attached to this event.
+		///Functions with a higher priority are called first. Returns a handle that can be passed to Unbind later on.
+		///</summary>
+		template <typename CallerType>
+		ListenerHandle Bind(ReturnType (CallerType::* funcPtr)(Args...), CallerType& caller, int priority = 0)
+		{
+			return TrackCaller(caller, BindWrapper<RegularMemberFunctionWrapper<CallerType, ReturnType, Args...>>(priority, funcPtr, caller));
+		}
+		
+		///<summary>
+		///Receives a const member function from a given object and stores it in the list of functions attached to this event.
+		///Functions with a higher priority are called first. Returns a handle that can be passed to Unbind later on.
+		///</summary>
+		template <typename CallerType>
+		ListenerHandle Bind(ReturnType(CallerType::* funcPtr) (Args...) const, CallerType& caller, int priority = 0)
+		{
+			return TrackCaller(caller, BindWrapper<ConstMemberFunctionWrapper<CallerType, ReturnType, Args...>>(priority, funcPtr, caller));
+		}
+
+		///<summary>
+		///Receives a global function and stores it in the list of functions attached to this event.
+		///Functions with a higher priority are called first. Returns a handle that can be passed to Unbind later on.
+		///</summary>
+		ListenerHandle Bind(ReturnType(*funcPtr)(Args...), int priority = 0)
+		{
+			return BindWrapper<GlobalFunctionWrapper<ReturnType, Args...>>(priority, funcPtr);
+		}
+
+		///<summary>
+		///Receives a lambda or any other function object callable with the event's arguments, and stores a copy of it in the list
+		///of functions attached to this event. Small ones are stored right in the function's slot, just like any other function,
+		///bigger ones in a block of the event's memory resource. Only unbound through the returned handle.
+		///</summary>
+		template <typename CallableType, typename = std::enable_if_t<IsBindableCallable<CallableType>::value>>
+		ListenerHandle Bind(CallableType&& callable, int priority = 0)
+		{
+			using StoredType = std::decay_t<CallableType>;
+			using InlineWrapper = CallableWrapper<StoredType, ReturnType, Args...>;
+			//Slots get copied around as functions are bound and unbound, which must not throw halfway through.
+			if constexpr (sizeof(InlineWrapper) <= Listener<ReturnType, Args...>::StorageSize && alignof(InlineWrapper) <= alignof(void*) &&
+				std::is_nothrow_copy_constructible<StoredType>::value)
+			{
+				return BindWrapper<InlineWrapper>(priority, std::forward<CallableType>(callable));
+			}
+			else
+			{
+				return BindWrapper<SharedCallableWrapper<StoredType, ReturnType, Args...>>(priority, GetMemoryResource(), std::forward<CallableType>(callable));
+			}
+		}
+
+		///<summary>
+		///Binds a function exactly like Bind, taking the same arguments, and returns a Subscription that unbinds it when destroyed.
+		///</summary>
+		template <typename ...BindArgs>
+		Subscription Subscribe(BindArgs&& ...bindArgs)
+		{
+			return MakeSubscription(Bind(std::forward<BindArgs>(bindArgs)...));
+		}
+
+		///<summary>
+		///Removes the function identified by the given handle in constant time. Stale or invalid handles are ignored.
+		///</summary>
+		void Unbind(ListenerHandle handle)
+		{
+			if (!IsBound(handle))
+			{
+				return;
+			}
+
+			const std::uint32_t position = handleSlots[handle.index].position;
+			if ((position & PendingPosition) != 0)
+			{
+				UnbindPendingAt(position & ~PendingPosition);
+			}
+			else
+			{
+				UnbindAt(position);
+			}
+		}
+
+		///<summary>
+		///Whether the function identified by the given handle is still attached to this event.
+		///</summary>
+		bool IsBound(ListenerHandle handle) const
+		{
+			return handle.index < handleSlots.size() && handleSlots[handle.index].generation == handle.generation;
+		}
+
+		///<summary>
+		///Removes a global function from the list of functions attached to this event.
+		///Has to look through every bound function, prefer unbinding by handle on hot paths.
+		///</summary>
+		void Unbind(ReturnType(*funcPtr)(Args...))
+		{
+			UnbindFunction<GlobalFunctionWrapper<ReturnType, Args...>>
+				([funcPtr](GlobalFunctionWrapper<ReturnType, Args...>* v)
+					{ return (*v) == funcPtr; });
+		}
+
+		///<summary>
+		///Removes an object's member function from the list of functions attached to this event.
+		///</summary>
+		template <typename CallerType>
+		void Unbind(ReturnType (CallerType::* funcPtr)(Args...), CallerType& caller)
+		{
+			UnbindFunction<RegularMemberFunctionWrapper<CallerType, ReturnType, Args...>>
+				([funcPtr, &caller](RegularMemberFunctionWrapper<CallerType, ReturnType, Args...>* v)
+					{ return v->IsFunctionFromCaller(funcPtr, caller); });
+		}
+
+		///<summary>
+		///Removes an object's const member function from the list of functions attached to this event.
+		///</summary>
+		template <typename CallerType>
+		void Unbind(ReturnType(CallerType::* funcPtr) (Args...) const, CallerType& caller)
+		{
+			UnbindFunction<ConstMemberFunctionWrapper<CallerType, ReturnType, Args...>>
+				([funcPtr, &caller](ConstMemberFunctionWrapper<CallerType, ReturnType, Args...>* v)
+					{ return v->IsFunctionFromCaller(funcPtr, caller); });
+		}
+		
+		///<summary>
+		///Binds the same member function of every object in [first, last), eg. a whole vector of objects, or of pointers to them.
+		///Faster than binding them one by one: storage grows once, and a priority lower than every bound function only appends.
+		///Unbind them with UnbindRange or UnbindAllFromCaller.
+		///</summary>
+		template <typename CallerType, typename CallerIterator>
+		void BindRange(ReturnType (CallerType::* funcPtr)(Args...), CallerIterator first, CallerIterator last, int priority = 0)
+		{
+			BindCallers<RegularMemberFunctionWrapper<CallerType, ReturnType, Args...>, CallerType>(funcPtr, first, last, priority);
+		}
+
+		template <typename CallerType, typename CallerIterator>
+		void BindRange(ReturnType (CallerType::* funcPtr)(Args...) const, CallerIterator first, CallerIterator last, int priority = 0)
+		{
+			BindCallers<ConstMemberFunctionWrapper<CallerType, ReturnType, Args...>, CallerType>(funcPtr, first, last, priority);
+		}
+
+		///<summary>
+		///Removes the given member function of every object in [first, last), looking through the bound functions only once.
+		///</summary>
+		template <typename CallerType, typename CallerIterator>
+		void UnbindRange(ReturnType (CallerType::* funcPtr)(Args...), CallerIterator first, CallerIterator last)
+		{
+			UnbindCallers<RegularMemberFunctionWrapper<CallerType, ReturnType, Args...>, CallerType>(funcPtr, first, last);
+		}
+
+		template <typename CallerType, typename CallerIterator>
+		void UnbindRange(ReturnType (CallerType::* funcPtr)(Args...) const, CallerIterator first, CallerIterator last)
+		{
+			UnbindCallers<ConstMemberFunctionWrapper<CallerType, ReturnType, Args...>, CallerType>(funcPtr, first, last);
+		}
+
+		///<summary>
+		///Removes the functions identified by every handle in [first, last), each in constant time.
+		///The entries they leave behind are all dropped together, in a single pass on the next fire.
+		///</summary>
+		template <typename HandleIterator>
+		void UnbindRange(HandleIterator first, HandleIterator last)
+		{
+			for (; first != last; ++first)
+			{
+				Unbind(*first);
+			}
+		}
+
+		///<summary>
+		///Removes every member function of the given object, whatever the function, in a single pass over the bound functions.
+		///Lambdas are never tied to an object, even when they capture one.
+		///</summary>
+		template <typename CallerType>
+		void UnbindAllFromCaller(const CallerType& caller)
+		{
+			const void* address = &caller;
+			UnbindFunction<FunctionWrapperBase<ReturnType, Args...>>([address](FunctionWrapperBase<ReturnType, Args...>* v)
+				{ return v->GetCaller() == address; });
+		}
+
+		///<summary>
+		///Removes every function from the list of functions attached to this event.
+		///</summary>
+		void UnbindAll()
+		{
+			for (std::size_t i = 0; i < boundFunctions.size(); ++i)
+			{
+				if (functionSlots[i] != ListenerHandle::InvalidIndex)
+				{
+					UnbindAt(i);
+				}
+			}
+
+			for (std::size_t i = 0; i < pendingFunctions.size(); ++i)
+			{
+				if (pendingSlots[i] != ListenerHandle::InvalidIndex)
+				{
+					UnbindPendingAt(i);
+				}
+			}
+			pendingFunctions.clear();
+			pendingSlots.clear();
+			pendingPriorities.clear();
+			hasPending = false;
+
+			//While firing, the disabled functions stay in place until the next compaction.
+			if (dispatchDepth == 0)
+			{
+				boundFunctions.clear();
+				functionSlots.clear();
+				functionPriorities.clear();
+				unboundCount = 0;
+			}
+		}
+
+	};
+
+	///<summary>
+	///Something waiting for the next fire of an Event, notified with the fired arguments once, after every bound function.
+	///</summary>
+	template<typename... Args>
+	struct EventWaiter : IntrusiveLink
+	{
+		void(*notify)(EventWaiter& waiter, const Args& ...args) = nullptr;
+
+		~EventWaiter()
+		{
+			Unlink();
+		}
+	};
+
+	template<typename... Args>
+	class Event;
+
+	///<summary>
+	///Awaitable returned by Event::Next, for C++20 coroutines: co_await event.Next() suspends the coroutine until the event
+	///fires next, and resumes it with copies of the fired arguments. Nothing is allocated, the awaitable itself is the list node,
+	///and lives in the coroutine frame. Resumes with nothing for an event without arguments, the value of the argument for an
+	///event with a single one, and a tuple of all of them otherwise.
+	///Written against any coroutine handle type, so this header still compiles as C++17.
+	///</summary>
+	template<typename... Args>
+	class NextFire : private EventWaiter<Args...>
+	{
+	private:
+		Event<Args...>& event;
+		void* coroutine = nullptr;
+		void(*resume)(void* coroutine) = nullptr;
+		std::optional<std::tuple<std::decay_t<Args>...>> values;
+
+		template<typename HandleType>
+		static void Resume(void* coroutine)
+		{
+			HandleType::from_address(coroutine).resume();
+		}
+
+		static void Notify(EventWaiter<Args...>& waiter, const Args& ...args)
+		{
+			NextFire& self = static_cast<NextFire&>(waiter);
+			self.values.emplace(args...);
+			//May destroy this awaitable, along with the coroutine frame it lives in.
+			self.resume(self.coroutine);
+		}
+
+	public:
+		explicit NextFire(Event<Args...>& event) : event(event)
+		{
+			this->notify = &Notify;
+		}
+
+		NextFire(const NextFire&) = delete;
+		NextFire& operator =(const NextFire&) = delete;
+
+		bool await_ready() const
+		{
+			return false;
+		}
+
+		template<typename HandleType>
+		void await_suspend(HandleType handle)
+		{
+			coroutine = handle.address();
+			resume = &Resume<HandleType>;
+			event.AddWaiter(*this);
+		}
+
+		auto await_resume()
+		{
+			if constexpr (sizeof...(Args) == 0)
+			{
+				return;
+			}
+			else if constexpr (sizeof...(Args) == 1)
+			{
+				return std::move(std::get<0>(*values));
+			}
+			else
+			{
+				return std::move(*values);
+			}
+		}
+	};
+
+	/// <summary>
+	/// An event stores a vector of functions with no return value.
+	/// To bind a function to an event, said function must match the arguments required by the event.
+	/// Eg. for an Event<string, int>, any function that wishes to be bound to it must require
+	/// exclusively a string and an int parameters, in this exact order, and not return anything.
+	/// Coroutines can also wait for the next fire, with co_await event.Next() or co_await event.
+	/// </summary>
+	template<typename... Args>
+	class Event : public BasicEvent<void, Args...>
+	{
+		friend class NextFire<Args...>;
+
+	private:
+		/// Coroutines waiting for the next fire, notified after every bound function.
+		IntrusiveList waiters;
+
+		void AddWaiter(EventWaiter<Args...>& waiter)
+		{
+			waiters.PushBack(waiter);
+			this->SetHasWaiters(true);
+		}
+
+		/// Checks the flag in the first cache line of the event first, the list itself only while coroutines wait.
+		bool IsAwaited()
+		{
+			if (!this->HasWaiters())
+			{
+				return false;
+			}
+			//Waiters destroyed without being resumed unlink themselves, and leave the flag set.
+			this->SetHasWaiters(!waiters.IsEmpty());
+			return this->HasWaiters();
+		}
+
+		void ResumeWaiters(const Args& ... args)
+		{
+			//Detached first, so coroutines that wait again right away are only resumed by the next fire.
+			IntrusiveList resuming;
+			resuming.TakeAll(waiters);
+			this->SetHasWaiters(false);
+			while (IntrusiveLink* link = resuming.PopFront())
+			{
+				EventWaiter<Args...>& waiter = static_cast<EventWaiter<Args...>&>(*link);
+				waiter.notify(waiter, args...);
+			}
+		}
+
+	public:
+		using BasicEvent<void, Args...>::BasicEvent;
+
+		///<summary>
+		///Calls every bound function with the given arguments. When passing rvalues, only the last function receives them as is,
+		///every other one gets its own copy, so no function ever sees an argument a previous one moved from.
+		///Move-only arguments, eg. a std::unique_ptr, are handed to every function as the same rvalue instead.
+		///</summary>
+		void operator() (Args&& ... args)
+		{
+			if constexpr ((IsRepeatable<Args> && ...))
+			{
+				//Waiters still need the arguments after the last function.
+				if (IsAwaited())
+				{
+					Broadcast(args...);
+					return;
+				}
+
+				this->CallBound([&](const Listener<void, Args...>* first, const Listener<void, Args...>* last)
+					{ Listener<void, Args...>::CallAll(first, last, std::forward<Args>(args)...); });
+			}
+			else
+			{
+				//Move-only arguments can't be kept intact for the waiters, they get what the last function left.
+				this->CallBound([&](const Listener<void, Args...>* first, const Listener<void, Args...>* last)
+					{
+						Listener<void, Args...>::CallAll(first, last, std::forward<Args>(args)...);
+						if (IsAwaited())
+						{
+							ResumeWaiters(args...);
+						}
+					});
+			}
+		}
+
+		///<summary>
+		///Fires the event without moving from the given arguments, which also makes it usable with lvalues and const objects.
+		///Every function taking a value argument gets its own copy. For zero-copy fan-out, declare the event with const
+		///reference arguments instead, eg. Event<const Message&>, and no function ever gets a copy.
+		///</summary>
+		void Broadcast(const Args& ... args)
+		{
+			this->CallBound([&](const Listener<void, Args...>* first, const Listener<void, Args...>* last)
+				{
+					Listener<void, Args...>::CallAllConst(first, last, args...);
+					if (IsAwaited())
+					{
+						ResumeWaiters(args...);
+					}
+				});
+		}
+
+		///<summary>
+		///Fires the event like Broadcast, with the bound functions split in chunks of grainSize run in parallel on the given pool,
+		///eg. a ThreadPool, or any type with the same ParallelFor. Returns once every function is done.
+		///Only for functions that are independent of each other and don't bind to or unbind from this event, nor run in any order.
+		///Waiting coroutines are resumed afterwards, on the calling thread.
+		///</summary>
+		template <typename PoolType>
+		void FireParallel(PoolType& pool, std::size_t grainSize, const Args& ... args)
+		{
+			this->CallBound([&](const Listener<void, Args...>* first, const Listener<void, Args...>* last)
+				{
+					pool.ParallelFor(static_cast<std::size_t>(last - first), grainSize, [&](std::size_t begin, std::size_t end)
+						{ Listener<void, Args...>::CallAllConst(first + begin, first + end, args...); });
+					if (IsAwaited())
+					{
+						ResumeWaiters(args...);
+					}
+				});
+		}
+
+		///<summary>
+		///Awaitable that resumes the awaiting coroutine on the next fire. Coroutines still waiting when the event is destroyed
+		///are never resumed.
+		///</summary>
+		NextFire<Args...> Next()
+		{
+			return NextFire<Args...>(*this);
+		}
+
+#if defined(__cpp_impl_coroutine)
+		/// Same as co_await Next().
+		NextFire<Args...> operator co_await()
+		{
+			return Next();
+		}
+#endif
+	};
+
+	/// <summary>
+	/// Event whose functions return whether they handled it. Firing stops at the first function that returns true,
+	/// so the functions after it, usually the ones with a lower priority, are never called.
+	/// </summary>
+	template<typename... Args>
+	class ConsumableEvent : public BasicEvent<bool, Args...>
+	{
+	public:
+		using BasicEvent<bool, Args...>::BasicEvent;
+
+		///<summary>
+		///Calls the bound functions in order until one of them returns true. Returns whether any function handled the event.
+		///Arguments are handed over the same way Event does.
+		///</summary>
+		bool operator() (Args&& ... args)
+		{
+			return this->CallBound([&](const Listener<bool, Args...>* first, const Listener<bool, Args...>* last)
+				{ return Listener<bool, Args...>::CallUntilHandled(first, last, std::forward<Args>(args)...); });
+		}
+
+		///<summary>
+		///Same as operator(), without ever moving from the given arguments.
+		///</summary>
+		bool Broadcast(const Args& ... args)
+		{
+			return this->CallBound([&](const Listener<bool, Args...>* first, const Listener<bool, Args...>* last)
+				{ return Listener<bool, Args...>::CallUntilHandledConst(first, last, args...); });
+		}
+	};
+}
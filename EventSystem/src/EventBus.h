@@ -0,0 +1,165 @@
+#pragma once
+#include "Event.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Events
+{
+	///<summary>
+	///Hands out consecutive indices, the first time each payload type asks for one, so an EventBus can find the event of a type
+	///with a plain array index. Indices are shared by every bus in the program.
+	///Each shared library that instantiates the same type gets an index of its own, so a bus should not be shared across them.
+	///</summary>
+	class EventTypeIndex
+	{
+	private:
+		static std::size_t Next()
+		{
+			static std::atomic<std::size_t> next{ 0 };
+			return next.fetch_add(1, std::memory_order_relaxed);
+		}
+
+	public:
+		template<typename PayloadType>
+		static std::size_t Of()
+		{
+			static const std::size_t index = Next();
+			return index;
+		}
+	};
+
+	///<summary>
+	///Connects publishers and subscribers through the type of the payload they exchange, eg. a DamageEvent struct, instead of
+	///a shared Event instance or a string key. Each payload type gets an Event<const PayloadType&>, created the first time
+	///it's needed, and found again through a dense integer index, so publishing only costs an array index on top of the fire.
+	///Not thread safe, just like the events it holds.
+	///</summary>
+	class EventBus
+	{
+	private:
+		struct ChannelBase
+		{
+			virtual ~ChannelBase() = default;
+		};
+
+		template<typename PayloadType>
+		struct Channel : ChannelBase
+		{
+			Event<const PayloadType&> event;
+
+			explicit Channel(std::pmr::memory_resource* resource) : event(resource) { }
+		};
+
+		/// Indexed by EventTypeIndex. Empty entries belong to types that were never used with this bus.
+		/// Each event sits in a block of its own, so it never moves while it's firing, even if firing it creates a new one.
+		std::vector<std::unique_ptr<ChannelBase>> channels;
+		std::pmr::memory_resource* resource;
+
+		template<typename PayloadType>
+		Event<const PayloadType&>* Find() const
+		{
+			const std::size_t index = EventTypeIndex::Of<PayloadType>();
+			return index < channels.size() && channels[index] ? &static_cast<Channel<PayloadType>&>(*channels[index]).event : nullptr;
+		}
+
+	public:
+		EventBus() : EventBus(std::pmr::get_default_resource()) { }
+
+		///<summary>
+		///Creates a bus whose events take the memory for their functions from the given resource, which must outlive the bus.
+		///</summary>
+		explicit EventBus(std::pmr::memory_resource* resource) : resource(resource) { }
+
+		EventBus(const EventBus&) = delete;
+		EventBus& operator =(const EventBus&) = delete;
+
+		///<summary>
+		///Event of the given payload type, created on first use. The reference stays valid for as long as the bus lives.
+		///</summary>
+		template<typename PayloadType>
+		Event<const PayloadType&>& Get()
+		{
+			static_assert(std::is_same<PayloadType, std::decay_t<PayloadType>>::value, "Payload types must be plain, non-reference types.");
+			if (Event<const PayloadType&>* event = Find<PayloadType>())
+			{
+				return *event;
+			}
+
+			const std::size_t index = EventTypeIndex::Of<PayloadType>();
+			if (index >= channels.size())
+			{
+				channels.resize(index + 1);
+			}
+			channels[index] = std::make_unique<Channel<PayloadType>>(resource);
+			return static_cast<Channel<PayloadType>&>(*channels[index]).event;
+		}
+
+		///<summary>
+		///Binds a function to the event of the given payload type, taking the same arguments as Event::Bind.
+		///Returns a handle that can be passed to Unbind later on.
+		///</summary>
+		template<typename PayloadType, typename ...BindArgs>
+		ListenerHandle Bind(BindArgs&& ...bindArgs)
+		{
+			return Get<PayloadType>().Bind(std::forward<BindArgs>(bindArgs)...);
+		}
+
+		///<summary>
+		///Same as Bind, returning a Subscription that unbinds the function when it's destroyed, just like Event::Subscribe.
+		///</summary>
+		template<typename PayloadType, typename ...BindArgs>
+		Subscription Subscribe(BindArgs&& ...bindArgs)
+		{
+			return Get<PayloadType>().Subscribe(std::forward<BindArgs>(bindArgs)...);
+		}
+
+		template<typename PayloadType>
+		void Unbind(ListenerHandle handle)
+		{
+			if (Event<const PayloadType&>* event = Find<PayloadType>())
+			{
+				event->Unbind(handle);
+			}
+		}
+
+		///<summary>
+		///Fires the event of the given payload type. Takes either the payload itself, which is passed on by reference,
+		///or the arguments to construct one with. Does nothing, not even construct the payload, if no one ever subscribed to it.
+		///</summary>
+		template<typename PayloadType, typename ...PayloadArgs>
+		void Publish(PayloadArgs&& ...payloadArgs)
+		{
+			Event<const PayloadType&>* event = Find<PayloadType>();
+			if (event == nullptr)
+			{
+				return;
+			}
+
+			if constexpr (sizeof...(PayloadArgs) == 1 && (std::is_same<std::decay_t<PayloadArgs>, PayloadType>::value && ...))
+			{
+				(*event)(payloadArgs...);
+			}
+			else
+			{
+				const PayloadType payload{ std::forward<PayloadArgs>(payloadArgs)... };
+				(*event)(payload);
+			}
+		}
+
+		///<summary>
+		///Whether any function is bound to the event of the given payload type.
+		///</summary>
+		template<typename PayloadType>
+		bool HasSubscribers() const
+		{
+			const Event<const PayloadType&>* event = Find<PayloadType>();
+			return event != nullptr && event->ListenerCount() > 0;
+		}
+	};
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include "DeferredEvent.h"
+#include "MpscQueue.h"
+
+#include <cstddef>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Events
+{
+	///<summary>
+	///Event fired from any thread but delivered on the one that owns it. operator() moves the arguments into a preallocated,
+	///lock-free queue, and the bound functions run later on the owning thread, when it calls Dispatch or Drain.
+	///Binding, unbinding, Dispatch and Drain must all happen on the owning thread; only operator() is thread-safe.
+	///Listeners always receive the queued copies, also for reference arguments.
+	///</summary>
+	template<typename... Args>
+	class EventChannel : public DeferredEvent<Args...>
+	{
+	public:
+		using Payload = typename DeferredEvent<Args...>::Payload;
+
+	private:
+		MpscQueue<Payload> pending;
+
+	public:
+		///<summary>
+		///Creates a channel able to hold at least the given amount of pending payloads.
+		///</summary>
+		explicit EventChannel(std::size_t capacity) : pending(capacity) { }
+
+		///<summary>
+		///Same as above, with the bound functions stored in the given memory resource. The queue itself is still allocated up front.
+		///</summary>
+		EventChannel(std::size_t capacity, std::pmr::memory_resource* resource) : DeferredEvent<Args...>(resource), pending(capacity) { }
+
+		///<summary>
+		///Queues the given arguments for the owning thread without calling anything. Safe to call from any thread,
+		///never allocates nor blocks. Returns false, dropping the arguments, if the queue is full.
+		///</summary>
+		bool operator() (Args&& ... args)
+		{
+			return pending.Emplace(std::forward<Args>(args)...);
+		}
+
+		///<summary>
+		///Delivers pending payloads until the queue is empty, oldest first. Stops after Capacity() payloads, so producers
+		///that never stop posting can't keep the owning thread here forever. Returns the amount of payloads delivered.
+		///</summary>
+		std::size_t Dispatch()
+		{
+			return Drain(pending.Capacity());
+		}
+
+		///<summary>
+		///Delivers up to the given amount of pending payloads, oldest first. Returns the amount of payloads delivered.
+		///</summary>
+		std::size_t Drain(std::size_t maxCount)
+		{
+			std::size_t delivered = 0;
+			Payload* front;
+			while (delivered < maxCount && (front = pending.Front()) != nullptr)
+			{
+				//Taken out of the queue first, so the slot is free for producers while the functions run.
+				Payload payload(std::move(*front));
+				pending.PopFront();
+				this->Deliver(payload);
+				++delivered;
+			}
+			return delivered;
+		}
+
+		///<summary>
+		///Drops every pending payload without delivering it.
+		///</summary>
+		void ClearPending()
+		{
+			while (pending.Front() != nullptr)
+			{
+				pending.PopFront();
+			}
+		}
+
+		///<summary>
+		///Amount of payloads waiting to be delivered. Only a snapshot while other threads keep posting.
+		///</summary>
+		std::size_t PendingCount() const
+		{
+			return pending.ApproximateSize();
+		}
+
+		std::size_t PendingCapacity() const
+		{
+			return pending.Capacity();
+		}
+	};
+}
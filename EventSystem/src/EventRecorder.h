@@ -0,0 +1,560 @@
+#pragma once
+#include "Event.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Events
+{
+	///<summary>
+	///Layout of an event log: a FileHeader, then one record after the other, each a RecordHeader followed by the arguments of a
+	///single fire, copied byte for byte one after the other and padded to RecordAlignment.
+	///</summary>
+	struct EventLogFormat
+	{
+		static constexpr std::uint32_t Magic = 0x474C5645u; // "EVLG"
+		static constexpr std::uint32_t Version = 1;
+		static constexpr std::size_t RecordAlignment = 8;
+
+		struct FileHeader
+		{
+			std::uint32_t magic;
+			std::uint32_t version;
+		};
+
+		struct RecordHeader
+		{
+			/// Order of the fire among every fire recorded by the same recorder, whichever thread it happened on.
+			std::uint64_t sequence;
+			std::uint32_t channel;
+			/// Bytes of arguments following the header, without the padding.
+			std::uint32_t size;
+		};
+
+		static constexpr std::size_t Padded(std::size_t size)
+		{
+			return (size + RecordAlignment - 1) / RecordAlignment * RecordAlignment;
+		}
+
+		template<typename... Values>
+		static constexpr std::size_t PayloadSize()
+		{
+			return (std::size_t(0) + ... + sizeof(Values));
+		}
+
+		/// Bytes a single fire with the given arguments takes in the log, header and padding included.
+		template<typename... Values>
+		static constexpr std::size_t RecordSize()
+		{
+			return Padded(sizeof(RecordHeader) + PayloadSize<Values...>());
+		}
+	};
+
+	///<summary>
+	///Captures every fire of the events it's asked to record into an append-only binary log, to be fed back by an EventPlayer.
+	///Each fire is copied into a buffer of the thread it happens on, without locking anything another thread uses, and full
+	///buffers are written to the file by a background thread. Only events whose arguments are all trivially copyable can be
+	///recorded, since they're stored as raw bytes: pointers in them will point nowhere once played back in another process.
+	///</summary>
+	class EventRecorder
+	{
+	private:
+		struct Chunk
+		{
+			std::unique_ptr<unsigned char[]> bytes;
+			std::size_t used = 0;
+		};
+
+		///<summary>
+		///Chunk the fires of a single thread go to. Its mutex is only ever taken by another thread when flushing.
+		///</summary>
+		struct ThreadBuffer
+		{
+			std::mutex mutex;
+			Chunk chunk;
+		};
+
+		/// Last buffer the calling thread wrote to, saving the lookup as long as it keeps recording with the same recorder.
+		struct LocalCache
+		{
+			std::uint64_t recorderId = 0;
+			ThreadBuffer* buffer = nullptr;
+		};
+
+		static std::uint64_t NextRecorderId()
+		{
+			static std::atomic<std::uint64_t> next{ 1 };
+			return next.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		const std::uint64_t id = NextRecorderId();
+		const std::size_t chunkSize;
+		std::FILE* file = nullptr;
+		std::atomic<std::uint64_t> nextSequence{ 0 };
+
+		std::mutex buffersMutex;
+		std::unordered_map<std::thread::id, std::unique_ptr<ThreadBuffer>> buffers;
+
+		/// Chunks waiting to be written, and written ones ready for reuse. Guarded by queueMutex.
+		std::mutex queueMutex;
+		std::condition_variable chunkQueued;
+		std::condition_variable chunkWritten;
+		std::deque<Chunk> fullChunks;
+		std::vector<Chunk> freeChunks;
+		std::uint64_t submittedCount = 0;
+		std::uint64_t writtenCount = 0;
+		bool stopping = false;
+		std::thread writer;
+
+		Chunk NewChunk()
+		{
+			std::lock_guard<std::mutex> lock(queueMutex);
+			if (!freeChunks.empty())
+			{
+				Chunk chunk = std::move(freeChunks.back());
+				freeChunks.pop_back();
+				return chunk;
+			}
+			return Chunk{ std::make_unique<unsigned char[]>(chunkSize), 0 };
+		}
+
+		/// Hands the given chunk over to the writer and replaces it with an empty one.
+		void Submit(Chunk& chunk)
+		{
+			Chunk fresh = NewChunk();
+			{
+				std::lock_guard<std::mutex> lock(queueMutex);
+				fullChunks.push_back(std::move(chunk));
+				++submittedCount;
+			}
+			chunkQueued.notify_one();
+			chunk = std::move(fresh);
+		}
+
+		ThreadBuffer& LocalBuffer()
+		{
+			thread_local LocalCache cache;
+			if (cache.recorderId != id)
+			{
+				std::lock_guard<std::mutex> lock(buffersMutex);
+				std::unique_ptr<ThreadBuffer>& buffer = buffers[std::this_thread::get_id()];
+				if (!buffer)
+				{
+					buffer = std::make_unique<ThreadBuffer>();
+					buffer->chunk = NewChunk();
+				}
+				cache = { id, buffer.get() };
+			}
+			return *cache.buffer;
+		}
+
+		void WriterLoop()
+		{
+			std::unique_lock<std::mutex> lock(queueMutex);
+			while (true)
+			{
+				chunkQueued.wait(lock, [this] { return stopping || !fullChunks.empty(); });
+				if (fullChunks.empty())
+				{
+					return;
+				}
+
+				Chunk chunk = std::move(fullChunks.front());
+				fullChunks.pop_front();
+				lock.unlock();
+				std::fwrite(chunk.bytes.get(), 1, chunk.used, file);
+				chunk.used = 0;
+				lock.lock();
+
+				freeChunks.push_back(std::move(chunk));
+				++writtenCount;
+				chunkWritten.notify_all();
+			}
+		}
+
+		template<typename... Values>
+		void Write(std::uint32_t channel, const Values& ...values)
+		{
+			constexpr std::size_t payloadSize = EventLogFormat::PayloadSize<Values...>();
+			constexpr std::size_t recordSize = EventLogFormat::RecordSize<Values...>();
+
+			ThreadBuffer& buffer = LocalBuffer();
+			std::lock_guard<std::mutex> lock(buffer.mutex);
+			if (buffer.chunk.used + recordSize > chunkSize)
+			{
+				Submit(buffer.chunk);
+			}
+
+			unsigned char* record = buffer.chunk.bytes.get() + buffer.chunk.used;
+			const EventLogFormat::RecordHeader header{ nextSequence.fetch_add(1, std::memory_order_relaxed), channel, static_cast<std::uint32_t>(payloadSize) };
+			std::memcpy(record, &header, sizeof(header));
+			unsigned char* payload = record + sizeof(header);
+			((std::memcpy(payload, &values, sizeof(Values)), payload += sizeof(Values)), ...);
+			std::memset(payload, 0, record + recordSize - payload);
+			buffer.chunk.used += recordSize;
+		}
+
+	public:
+		///<summary>
+		///Creates or truncates the log at the given path. Fires are gathered in chunks of the given size per thread,
+		///which also bounds the size of a single fire, see CanRecord. Chunks are never smaller than a record without arguments.
+		///</summary>
+		explicit EventRecorder(const char* path, std::size_t chunkSize = 64 * 1024) :
+			chunkSize(std::max(EventLogFormat::Padded(chunkSize), EventLogFormat::RecordSize<>())), file(std::fopen(path, "wb"))
+		{
+			if (file != nullptr)
+			{
+				const EventLogFormat::FileHeader header{ EventLogFormat::Magic, EventLogFormat::Version };
+				std::fwrite(&header, sizeof(header), 1, file);
+				writer = std::thread([this] { WriterLoop(); });
+			}
+		}
+
+		EventRecorder(const EventRecorder&) = delete;
+		EventRecorder& operator =(const EventRecorder&) = delete;
+
+		///<summary>
+		///Writes out everything recorded so far. Every recording must have been stopped by then.
+		///</summary>
+		~EventRecorder()
+		{
+			if (file == nullptr)
+			{
+				return;
+			}
+
+			Flush();
+			{
+				std::lock_guard<std::mutex> lock(queueMutex);
+				stopping = true;
+			}
+			chunkQueued.notify_one();
+			writer.join();
+			std::fclose(file);
+		}
+
+		bool IsOpen() const
+		{
+			return file != nullptr;
+		}
+
+		///<summary>
+		///Whether a single fire with the given arguments fits in a chunk, and so can be recorded.
+		///</summary>
+		template<typename... Args>
+		bool CanRecord() const
+		{
+			return EventLogFormat::RecordSize<std::decay_t<Args>...>() <= chunkSize;
+		}
+
+		///<summary>
+		///Starts recording every fire of the given event under the given channel, which the player uses to find the event
+		///to feed the fire to. Recording stops once the returned subscription is destroyed, which must happen before the
+		///recorder is. Fires are recorded before any function of the event runs, whatever their priority.
+		///Returns an empty subscription, recording nothing, if the log couldn't be opened or the event's arguments don't fit
+		///in a chunk.
+		///</summary>
+		template<typename... Args>
+		Subscription Record(Event<Args...>& event, std::uint32_t channel)
+		{
+			static_assert((std::is_trivially_copyable<std::decay_t<Args>>::value && ...), "Only trivially copyable arguments can be recorded.");
+			static_assert(EventLogFormat::PayloadSize<std::decay_t<Args>...>() <= UINT32_MAX, "Arguments are too big to be recorded.");
+			if (file == nullptr || !CanRecord<Args...>())
+			{
+				return Subscription();
+			}
+
+			return event.Subscribe([this, channel](const std::decay_t<Args>& ...args) { Write(channel, args...); }, INT_MAX);
+		}
+
+		///<summary>
+		///Writes out everything recorded so far, on every thread, and returns once it's in the file.
+		///</summary>
+		void Flush()
+		{
+			if (file == nullptr)
+			{
+				return;
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(buffersMutex);
+				for (auto& buffer : buffers)
+				{
+					std::lock_guard<std::mutex> bufferLock(buffer.second->mutex);
+					if (buffer.second->chunk.used > 0)
+					{
+						Submit(buffer.second->chunk);
+					}
+				}
+			}
+
+			std::unique_lock<std::mutex> lock(queueMutex);
+			chunkWritten.wait(lock, [this] { return writtenCount == submittedCount; });
+			std::fflush(file);
+		}
+
+		///<summary>
+		///Amount of fires recorded so far, written out or not.
+		///</summary>
+		std::uint64_t RecordCount() const
+		{
+			return nextSequence.load(std::memory_order_relaxed);
+		}
+	};
+
+	///<summary>
+	///Read-only view of a whole file, mapped into memory.
+	///</summary>
+	class MappedFile
+	{
+	private:
+		const unsigned char* data = nullptr;
+		std::size_t size = 0;
+#if defined(_WIN32)
+		HANDLE file = INVALID_HANDLE_VALUE;
+		HANDLE mapping = nullptr;
+#endif
+
+	public:
+		explicit MappedFile(const char* path)
+		{
+#if defined(_WIN32)
+			file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			LARGE_INTEGER fileSize;
+			if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+			{
+				return;
+			}
+			mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping == nullptr)
+			{
+				return;
+			}
+			data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+			size = data != nullptr ? static_cast<std::size_t>(fileSize.QuadPart) : 0;
+#else
+			const int descriptor = open(path, O_RDONLY);
+			if (descriptor < 0)
+			{
+				return;
+			}
+			struct stat status;
+			if (fstat(descriptor, &status) == 0 && status.st_size > 0)
+			{
+				void* mapped = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+				if (mapped != MAP_FAILED)
+				{
+					data = static_cast<const unsigned char*>(mapped);
+					size = static_cast<std::size_t>(status.st_size);
+				}
+			}
+			//The mapping stays valid without the descriptor.
+			close(descriptor);
+#endif
+		}
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator =(const MappedFile&) = delete;
+
+		~MappedFile()
+		{
+#if defined(_WIN32)
+			if (data != nullptr)
+			{
+				UnmapViewOfFile(data);
+			}
+			if (mapping != nullptr)
+			{
+				CloseHandle(mapping);
+			}
+			if (file != INVALID_HANDLE_VALUE)
+			{
+				CloseHandle(file);
+			}
+#else
+			if (data != nullptr)
+			{
+				munmap(const_cast<unsigned char*>(data), size);
+			}
+#endif
+		}
+
+		const unsigned char* Data() const
+		{
+			return data;
+		}
+
+		std::size_t Size() const
+		{
+			return size;
+		}
+	};
+
+	///<summary>
+	///Feeds the fires of a log written by an EventRecorder back through the events attached to their channels, in the order
+	///they were recorded in, at full speed. The log is memory-mapped and indexed once when opened; playing it back decodes every
+	///fire straight into the arguments of the event, without allocating anything.
+	///</summary>
+	class EventPlayer
+	{
+	private:
+		struct Target
+		{
+			void* event;
+			std::uint32_t size;
+			void(*deliver)(void* event, const unsigned char* payload);
+		};
+
+		MappedFile file;
+		/// Every complete record of the log, sorted by sequence.
+		std::vector<const unsigned char*> records;
+		std::unordered_map<std::uint32_t, Target> targets;
+		bool valid = false;
+
+		template<typename... Args, std::size_t ...Indices>
+		static void Deliver(void* event, const unsigned char* payload, std::index_sequence<Indices...>)
+		{
+			std::tuple<std::decay_t<Args>...> values;
+			((std::memcpy(&std::get<Indices>(values), payload, sizeof(std::get<Indices>(values))), payload += sizeof(std::get<Indices>(values))), ...);
+			(*static_cast<Event<Args...>*>(event))(static_cast<Args&&>(std::get<Indices>(values))...);
+		}
+
+		template<typename... Args>
+		static void Deliver(void* event, const unsigned char* payload)
+		{
+			Deliver<Args...>(event, payload, std::index_sequence_for<Args...>());
+		}
+
+		static EventLogFormat::RecordHeader HeaderAt(const unsigned char* record)
+		{
+			EventLogFormat::RecordHeader header;
+			std::memcpy(&header, record, sizeof(header));
+			return header;
+		}
+
+		void Index()
+		{
+			const unsigned char* position = file.Data();
+			const unsigned char* end = position + file.Size();
+			EventLogFormat::FileHeader header;
+			if (file.Size() < sizeof(header))
+			{
+				return;
+			}
+			std::memcpy(&header, position, sizeof(header));
+			if (header.magic != EventLogFormat::Magic || header.version != EventLogFormat::Version)
+			{
+				return;
+			}
+
+			valid = true;
+			position += sizeof(header);
+			//A log cut short, eg. by a crash, still plays back up to its last complete record.
+			while (static_cast<std::size_t>(end - position) >= sizeof(EventLogFormat::RecordHeader))
+			{
+				const std::size_t recordSize = EventLogFormat::Padded(sizeof(EventLogFormat::RecordHeader) + HeaderAt(position).size);
+				if (static_cast<std::size_t>(end - position) < recordSize)
+				{
+					break;
+				}
+				records.push_back(position);
+				position += recordSize;
+			}
+
+			//Each thread's records are in order already, only whole chunks of different threads are interleaved.
+			std::stable_sort(records.begin(), records.end(), [](const unsigned char* left, const unsigned char* right)
+				{ return HeaderAt(left).sequence < HeaderAt(right).sequence; });
+		}
+
+	public:
+		explicit EventPlayer(const char* path) : file(path)
+		{
+			Index();
+		}
+
+		///<summary>
+		///Whether the log could be opened and is one an EventRecorder wrote. An empty log still counts.
+		///</summary>
+		bool IsOpen() const
+		{
+			return valid;
+		}
+
+		///<summary>
+		///Feeds the fires recorded under the given channel to the given event, which must outlive the player.
+		///Fires of that channel whose arguments don't have the size of the event's are skipped.
+		///</summary>
+		template<typename... Args>
+		void Attach(std::uint32_t channel, Event<Args...>& event)
+		{
+			static_assert((std::is_trivially_copyable<std::decay_t<Args>>::value && ...), "Only trivially copyable arguments can be played back.");
+			targets[channel] = { &event, static_cast<std::uint32_t>(EventLogFormat::PayloadSize<std::decay_t<Args>...>()), &Deliver<Args...> };
+		}
+
+		void Detach(std::uint32_t channel)
+		{
+			targets.erase(channel);
+		}
+
+		///<summary>
+		///Fires every record of the log whose channel is attached, in recorded order. Returns the amount of fires delivered.
+		///</summary>
+		std::size_t Play()
+		{
+			return Play(0, records.size());
+		}
+
+		///<summary>
+		///Same as Play, for the records in [first, first + count) only, eg. to spread a long log over several frames.
+		///</summary>
+		std::size_t Play(std::size_t first, std::size_t count)
+		{
+			const std::size_t last = std::min(records.size(), first + std::min(count, records.size()));
+			std::size_t delivered = 0;
+			for (std::size_t i = first; i < last; ++i)
+			{
+				const EventLogFormat::RecordHeader header = HeaderAt(records[i]);
+				const auto found = targets.find(header.channel);
+				if (found != targets.end() && found->second.size == header.size)
+				{
+					found->second.deliver(found->second.event, records[i] + sizeof(EventLogFormat::RecordHeader));
+					++delivered;
+				}
+			}
+			return delivered;
+		}
+
+		std::size_t RecordCount() const
+		{
+			return records.size();
+		}
+	};
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "Event.h"
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace Events
+{
+	///<summary>
+	///Inline block of memory and the resource handing it out. A base of FixedEvent, so it's ready before the event is built.
+	///Anything asked for beyond the block throws std::bad_alloc instead of falling back to the heap.
+	///</summary>
+	template<std::size_t Size>
+	struct FixedEventBuffer
+	{
+		alignas(std::max_align_t) unsigned char bytes[Size];
+		std::pmr::monotonic_buffer_resource resource{ bytes, Size, std::pmr::null_memory_resource() };
+	};
+
+	///<summary>
+	///Number of entries a FixedEvent keeps for Capacity functions. The spare ones hold disabled entries, so unbinding and binding
+	///again while full only compacts once every Capacity / 4 binds.
+	///</summary>
+	template<std::size_t Capacity>
+	inline constexpr std::size_t FixedEventEntries = Capacity + Capacity / 4 + 1;
+
+	///<summary>
+	///Event able to hold up to Capacity functions, all stored in an inline buffer, so it never touches the heap: not when
+	///binding, unbinding or firing, and not when functions bind others while it fires. Meant for threads that must not allocate.
+	///Binding more than Capacity functions at once throws std::bad_alloc, as does binding and unbinding more than Capacity
+	///functions during a single fire, since those only make room once the fire is over.
+	///Function objects too big for a listener slot are taken from the same buffer, so only small ones are sure to fit.
+	///Member functions of a TrackedListener are the exception: the object keeps their subscriptions in a vector of its own,
+	///on the heap, so bind those ahead of time or from threads that may allocate.
+	///</summary>
+	template<std::size_t Capacity, typename... Args>
+	class FixedEvent : private FixedEventBuffer<Event<Args...>::MemoryNeeded(FixedEventEntries<Capacity>)>, public Event<Args...>
+	{
+		static_assert(Capacity > 0, "A FixedEvent must be able to hold at least one function.");
+		//When every entry is in use, at most Capacity are bound, so enough are disabled for binding to compact.
+		static_assert(FixedEventEntries<Capacity> - Capacity >= FixedEventEntries<Capacity> / Event<Args...>::CompactionRatio,
+			"A full FixedEvent must have enough disabled entries to compact.");
+
+	public:
+		FixedEvent() : Event<Args...>(&this->resource)
+		{
+			Event<Args...>::Reserve(FixedEventEntries<Capacity>);
+			this->ReservePending(Capacity);
+		}
+
+		/// The functions live in this event's own buffer, a copy would allocate them from the default resource instead.
+		FixedEvent(const FixedEvent&) = delete;
+		FixedEvent& operator =(const FixedEvent&) = delete;
+
+		/// The buffer was reserved in full on construction, and can't be given back to anything.
+		void Reserve(std::size_t) = delete;
+		void ShrinkToFit() = delete;
+
+		static constexpr std::size_t GetCapacity()
+		{
+			return Capacity;
+		}
+	};
+}
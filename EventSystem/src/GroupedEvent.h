@@ -0,0 +1,452 @@
+#pragma once
+#include "Event.h"
+#include "StaticEvent.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<version>)
+#include <version>
+#endif
+#if defined(__cpp_lib_span)
+#include <span>
+#endif
+
+namespace Events
+{
+#if defined(__cpp_lib_span)
+	template<typename ElementType>
+	using CallerSpan = std::span<ElementType>;
+#else
+	///<summary>
+	///Stand-in for std::span before C++20: a contiguous run of elements, as handed to a batch handler.
+	///</summary>
+	template<typename ElementType>
+	class CallerSpan
+	{
+	private:
+		ElementType* first;
+		std::size_t count;
+
+	public:
+		CallerSpan(ElementType* first, std::size_t count) : first(first), count(count) { }
+
+		ElementType* data() const { return first; }
+		std::size_t size() const { return count; }
+		bool empty() const { return count == 0; }
+		ElementType* begin() const { return first; }
+		ElementType* end() const { return first + count; }
+		ElementType& operator[](std::size_t index) const { return first[index]; }
+	};
+#endif
+
+	///<summary>
+	///Describes a function that handles a whole group of objects at once: a global or static function taking a span of callers,
+	///followed by the arguments of the event.
+	///</summary>
+	template<typename FunctionType>
+	struct BatchListenerTraits;
+
+	template<typename CallerType, typename ...Args>
+	struct BatchListenerTraits<void(*)(CallerSpan<CallerType*>, Args...)>
+	{
+		using Signature = void(Args...);
+		using CallerPointer = CallerType*;
+	};
+
+	///<summary>
+	///Event for many objects of the same type binding the same member function, eg. every Enemy binding &Enemy::OnExplosion.
+	///Instead of a wrapper per object, every (function, caller type) pair gets a group holding nothing but a dense array of
+	///caller pointers, and firing runs one tight loop per group with the function known at compile time, so it can be inlined.
+	///A function taking a span of callers can also be bound with BindBatch, to be called once with the whole group.
+	///Groups are called in the order they were first bound to. Within a group, objects are called in bind order, minus the
+	///ones unbound since. Functions may bind and unbind others while the event fires: unbound ones are skipped right away,
+	///and newly bound ones are only called starting with the next fire. Batch handlers get a null pointer for every
+	///object unbound during the fire in progress.
+	///Every function receives its own copy of value arguments, like with Event::Broadcast.
+	///</summary>
+	template<typename... Args>
+	class GroupedEvent
+	{
+	private:
+		struct HandleSlot
+		{
+			std::uint32_t generation;
+			/// Index into groups, or the next free slot for free entries.
+			std::uint32_t group;
+			std::uint32_t position;
+		};
+
+		///<summary>
+		///Callers sharing a single function, stored as a dense array in the concrete group.
+		///</summary>
+		struct GroupBase
+		{
+			/// Address of the WrapperTypeTag of the concrete group type, telling which function the group calls.
+			const void* key;
+			/// Handle slot owning each caller, or InvalidIndex once that caller was unbound.
+			std::vector<std::uint32_t> slots;
+			std::size_t unboundCount = 0;
+
+			explicit GroupBase(const void* key) : key(key) { }
+			virtual ~GroupBase() = default;
+
+			virtual void Fire(const Args& ...args) const = 0;
+			virtual void Append(void* caller) = 0;
+			virtual void Disable(std::size_t position) = 0;
+			/// Drops unbound callers in a single pass, keeping the order of the rest, and returns how many are left.
+			virtual std::size_t Compact(std::vector<HandleSlot>& handleSlots) = 0;
+			virtual void Clear() = 0;
+		};
+
+		template<typename CallerPointer>
+		struct CallerGroup : GroupBase
+		{
+			std::vector<CallerPointer> callers;
+
+			using GroupBase::GroupBase;
+
+			void Append(void* caller) override
+			{
+				callers.push_back(static_cast<CallerPointer>(caller));
+			}
+
+			void Disable(std::size_t position) override
+			{
+				callers[position] = nullptr;
+			}
+
+			std::size_t Compact(std::vector<HandleSlot>& handleSlots) override
+			{
+				std::size_t kept = 0;
+				for (std::size_t i = 0; i < callers.size(); ++i)
+				{
+					if (this->slots[i] == ListenerHandle::InvalidIndex)
+					{
+						continue;
+					}
+
+					callers[kept] = callers[i];
+					this->slots[kept] = this->slots[i];
+					handleSlots[this->slots[kept]].position = static_cast<std::uint32_t>(kept);
+					++kept;
+				}
+
+				callers.resize(kept);
+				this->slots.resize(kept);
+				this->unboundCount = 0;
+				return kept;
+			}
+
+			void Clear() override
+			{
+				callers.clear();
+				this->slots.clear();
+				this->unboundCount = 0;
+			}
+		};
+
+		template<auto Function>
+		struct MemberGroup : CallerGroup<typename StaticListenerTraits<decltype(Function)>::CallerPointer>
+		{
+			using CallerGroup<typename StaticListenerTraits<decltype(Function)>::CallerPointer>::CallerGroup;
+
+			void Fire(const Args& ...args) const override
+			{
+				//The range is fixed for the whole loop: callers bound meanwhile wait aside, unbound ones are only nulled.
+				for (auto caller = this->callers.data(), last = caller + this->callers.size(); caller != last; ++caller)
+				{
+					if (*caller != nullptr)
+					{
+						((*caller)->*Function)(static_cast<RepeatableArg<Args>>(args)...);
+					}
+				}
+			}
+		};
+
+		template<auto BatchFunction>
+		struct BatchGroup : CallerGroup<typename BatchListenerTraits<decltype(BatchFunction)>::CallerPointer>
+		{
+			using CallerPointer = typename BatchListenerTraits<decltype(BatchFunction)>::CallerPointer;
+			using CallerGroup<CallerPointer>::CallerGroup;
+
+			void Fire(const Args& ...args) const override
+			{
+				if (!this->callers.empty())
+				{
+					BatchFunction(CallerSpan<CallerPointer>(const_cast<CallerPointer*>(this->callers.data()), this->callers.size()),
+						static_cast<RepeatableArg<Args>>(args)...);
+				}
+			}
+		};
+
+		/// Caller bound while the event was firing, added to its group once the fire is over.
+		struct PendingCaller
+		{
+			GroupBase* group;
+			void* caller;
+			std::uint32_t slot;
+		};
+
+		/// Groups keep their address, so a group firing right now stays put when another group is created.
+		std::vector<std::unique_ptr<GroupBase>> groups;
+		std::vector<PendingCaller> pendingCallers;
+		std::vector<HandleSlot> handleSlots;
+		std::uint32_t freeSlot = ListenerHandle::InvalidIndex;
+		std::size_t liveSlots = 0;
+		std::size_t unboundCount = 0;
+		std::uint32_t dispatchDepth = 0;
+
+		/// Marks a HandleSlot position as an index into pendingCallers rather than the callers of its group.
+		static constexpr std::uint32_t PendingPosition = 0x80000000u;
+
+		struct DispatchScope
+		{
+			GroupedEvent& event;
+
+			explicit DispatchScope(GroupedEvent& event) : event(event)
+			{
+				++event.dispatchDepth;
+			}
+
+			~DispatchScope()
+			{
+				if (--event.dispatchDepth == 0 && !event.pendingCallers.empty())
+				{
+					event.AddPending();
+				}
+			}
+		};
+
+		template<typename GroupType>
+		std::uint32_t FindGroup()
+		{
+			const void* key = &WrapperTypeTag<GroupType>::value;
+			for (std::size_t i = 0; i < groups.size(); ++i)
+			{
+				if (groups[i]->key == key)
+				{
+					return static_cast<std::uint32_t>(i);
+				}
+			}
+
+			groups.push_back(std::make_unique<GroupType>(key));
+			return static_cast<std::uint32_t>(groups.size() - 1);
+		}
+
+		template<typename GroupType, typename CallerPointer>
+		ListenerHandle BindCaller(CallerPointer caller)
+		{
+			const std::uint32_t group = FindGroup<GroupType>();
+			const std::uint32_t slot = AcquireSlot();
+			handleSlots[slot].group = group;
+			void* erased = const_cast<void*>(static_cast<const void*>(caller));
+			if (dispatchDepth > 0)
+			{
+				handleSlots[slot].position = PendingPosition | static_cast<std::uint32_t>(pendingCallers.size());
+				pendingCallers.push_back({ groups[group].get(), erased, slot });
+			}
+			else
+			{
+				GroupBase& target = *groups[group];
+				//Keeps unbound callers from piling up when objects come and go without the event ever firing.
+				if (target.unboundCount > 0 && target.unboundCount >= target.slots.size() / 2)
+				{
+					unboundCount -= target.unboundCount;
+					target.Compact(handleSlots);
+				}
+				handleSlots[slot].position = static_cast<std::uint32_t>(target.slots.size());
+				target.Append(erased);
+				target.slots.push_back(slot);
+			}
+			return { slot, handleSlots[slot].generation };
+		}
+
+		std::uint32_t AcquireSlot()
+		{
+			std::uint32_t slot = freeSlot;
+			if (slot != ListenerHandle::InvalidIndex)
+			{
+				freeSlot = handleSlots[slot].group;
+			}
+			else
+			{
+				slot = static_cast<std::uint32_t>(handleSlots.size());
+				handleSlots.push_back({ 0, 0, 0 });
+			}
+			++liveSlots;
+			return slot;
+		}
+
+		void ReleaseSlot(std::uint32_t slot)
+		{
+			++handleSlots[slot].generation;
+			handleSlots[slot].group = freeSlot;
+			freeSlot = slot;
+			--liveSlots;
+		}
+
+		void AddPending()
+		{
+			for (const PendingCaller& pending : pendingCallers)
+			{
+				if (pending.slot == ListenerHandle::InvalidIndex)
+				{
+					continue;
+				}
+
+				handleSlots[pending.slot].position = static_cast<std::uint32_t>(pending.group->slots.size());
+				pending.group->Append(pending.caller);
+				pending.group->slots.push_back(pending.slot);
+			}
+			pendingCallers.clear();
+		}
+
+		void RemoveUnbound()
+		{
+			for (auto& group : groups)
+			{
+				if (group->unboundCount > 0)
+				{
+					group->Compact(handleSlots);
+				}
+			}
+			unboundCount = 0;
+		}
+
+	public:
+		GroupedEvent() = default;
+		GroupedEvent(const GroupedEvent&) = delete;
+		GroupedEvent& operator =(const GroupedEvent&) = delete;
+
+		///<summary>
+		///Adds the given object to the group of the member function given as template argument, eg. Bind<&Enemy::OnExplosion>(enemy).
+		///Returns a handle that can be passed to Unbind later on.
+		///</summary>
+		template<auto Function, typename CallerType>
+		ListenerHandle Bind(CallerType& caller)
+		{
+			using Traits = StaticListenerTraits<decltype(Function)>;
+			static_assert(Traits::IsMember, "Only member functions can be grouped by caller.");
+			static_assert(std::is_same<typename Traits::Signature, void(Args...)>::value, "Function must take the arguments of the event.");
+			static_assert(std::is_convertible<CallerType*, typename Traits::CallerPointer>::value, "Caller is not an object of the function's class.");
+			return BindCaller<MemberGroup<Function>>(static_cast<typename Traits::CallerPointer>(&caller));
+		}
+
+		///<summary>
+		///Adds the given object to the group of the batch handler given as template argument, a function such as
+		///void OnExplosionBatch(CallerSpan<Enemy*> enemies, Args... args), called once per fire with every object of its group.
+		///Returns a handle that can be passed to Unbind later on.
+		///</summary>
+		template<auto BatchFunction, typename CallerType>
+		ListenerHandle BindBatch(CallerType& caller)
+		{
+			using Traits = BatchListenerTraits<decltype(BatchFunction)>;
+			static_assert(std::is_same<typename Traits::Signature, void(Args...)>::value, "Batch handler must take the arguments of the event.");
+			static_assert(std::is_convertible<CallerType*, typename Traits::CallerPointer>::value, "Caller is not an object the batch handler takes.");
+			return BindCaller<BatchGroup<BatchFunction>>(static_cast<typename Traits::CallerPointer>(&caller));
+		}
+
+		///<summary>
+		///Removes the object identified by the given handle from its group in constant time. Stale or invalid handles are ignored.
+		///</summary>
+		void Unbind(ListenerHandle handle)
+		{
+			if (!IsBound(handle))
+			{
+				return;
+			}
+
+			const HandleSlot entry = handleSlots[handle.index];
+			ReleaseSlot(handle.index);
+			if ((entry.position & PendingPosition) != 0)
+			{
+				pendingCallers[entry.position & ~PendingPosition].slot = ListenerHandle::InvalidIndex;
+				return;
+			}
+
+			GroupBase& group = *groups[entry.group];
+			group.Disable(entry.position);
+			group.slots[entry.position] = ListenerHandle::InvalidIndex;
+			++group.unboundCount;
+			++unboundCount;
+		}
+
+		bool IsBound(ListenerHandle handle) const
+		{
+			return handle.index < handleSlots.size() && handleSlots[handle.index].generation == handle.generation;
+		}
+
+		void UnbindAll()
+		{
+			for (auto& group : groups)
+			{
+				for (std::size_t i = 0; i < group->slots.size(); ++i)
+				{
+					if (group->slots[i] != ListenerHandle::InvalidIndex)
+					{
+						ReleaseSlot(group->slots[i]);
+						group->Disable(i);
+						group->slots[i] = ListenerHandle::InvalidIndex;
+						++group->unboundCount;
+						++unboundCount;
+					}
+				}
+			}
+
+			for (const PendingCaller& pending : pendingCallers)
+			{
+				if (pending.slot != ListenerHandle::InvalidIndex)
+				{
+					ReleaseSlot(pending.slot);
+				}
+			}
+			pendingCallers.clear();
+
+			//While firing, the nulled callers stay in place until the next compaction.
+			if (dispatchDepth == 0)
+			{
+				for (auto& group : groups)
+				{
+					group->Clear();
+				}
+				unboundCount = 0;
+			}
+		}
+
+		///<summary>
+		///Calls every group, one after the other, with the given arguments.
+		///</summary>
+		void operator() (const Args& ... args)
+		{
+			if (unboundCount > 0 && dispatchDepth == 0)
+			{
+				RemoveUnbound();
+			}
+
+			DispatchScope scope(*this);
+			//Groups created by the functions being called are empty until the fire is over, no need to reach them.
+			for (std::size_t i = 0, count = groups.size(); i < count; ++i)
+			{
+				groups[i]->Fire(args...);
+			}
+		}
+
+		///<summary>
+		///Amount of objects bound right now, including the ones bound during the fire in progress.
+		///</summary>
+		std::size_t ListenerCount() const
+		{
+			return liveSlots;
+		}
+
+		std::size_t GroupCount() const
+		{
+			return groups.size();
+		}
+	};
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include "CacheAligned.h"
+#include "Event.h"
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace Events
+{
+	///<summary>
+	///Inline block big enough for Count listeners, handed out as a memory resource. A base of InlineEvent, so it's ready before
+	///the event is built. Anything that doesn't fit, or is asked for while the block is taken, comes from the upstream resource.
+	///Aligned on a cache line and padded to whole ones: the first listener fills the rest of the line after the vtable and
+	///upstream pointers, and the event itself starts on a line of its own.
+	///</summary>
+	template<typename ListenerType, std::size_t Count>
+	class alignas(CacheLineSize) InlineListenerBuffer : public std::pmr::memory_resource
+	{
+		static_assert(2 * sizeof(void*) + sizeof(ListenerType) <= CacheLineSize,
+			"The first inline listener must fit in the first cache line, along with the vtable and upstream pointers.");
+
+	private:
+		static constexpr std::size_t UsedBytes = 2 * sizeof(void*) + Count * sizeof(ListenerType) + sizeof(bool);
+		/// Rounded up to fill the lines of the buffer, as the event may start right after inUse, in its tail padding.
+		static constexpr std::size_t ByteCount = Count * sizeof(ListenerType) + (CacheLineSize - UsedBytes % CacheLineSize) % CacheLineSize;
+
+		std::pmr::memory_resource* upstream;
+		alignas(ListenerType) unsigned char bytes[ByteCount];
+		bool inUse = false;
+
+	protected:
+		explicit InlineListenerBuffer(std::pmr::memory_resource* upstream) : upstream(upstream) { }
+
+		void* do_allocate(std::size_t size, std::size_t alignment) override
+		{
+			if (!inUse && size <= sizeof(bytes) && alignment <= alignof(ListenerType))
+			{
+				inUse = true;
+				return bytes;
+			}
+			return upstream->allocate(size, alignment);
+		}
+
+		void do_deallocate(void* pointer, std::size_t size, std::size_t alignment) override
+		{
+			if (pointer == bytes)
+			{
+				inUse = false;
+				return;
+			}
+			upstream->deallocate(pointer, size, alignment);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+	};
+
+	///<summary>
+	///Event storing up to InlineCount bound functions inside itself rather than on the heap, so firing an event with that many
+	///functions or fewer never reads memory outside the event object. Meant for the many events that only ever get one or two
+	///functions, where fetching a separate block of listeners costs more than calling them.
+	///Always aligned on a cache line, so a fire with a single function reads two lines: the one holding that function, and the
+	///one holding the start of the event, see the members of BasicEvent. Any further inline function may span two more lines.
+	///Binding more than InlineCount functions moves them all to the memory resource, where they stay.
+	///Handles and the other bookkeeping of bound functions still come from the memory resource, firing never reads those.
+	///</summary>
+	template<std::size_t InlineCount, typename... Args>
+	class InlineEvent : private InlineListenerBuffer<Listener<void, Args...>, InlineCount>, public Event<Args...>
+	{
+		static_assert(InlineCount > 0, "An InlineEvent must be able to hold at least one function.");
+
+		using Buffer = InlineListenerBuffer<Listener<void, Args...>, InlineCount>;
+
+	public:
+		InlineEvent() : InlineEvent(std::pmr::get_default_resource()) { }
+
+		///<summary>
+		///Creates an event that takes all the memory it doesn't hold inline from the given resource, which must outlive the event.
+		///</summary>
+		explicit InlineEvent(std::pmr::memory_resource* resource) :
+			Buffer(resource), Event<Args...>(static_cast<Buffer*>(this), InlineCount, resource) { }
+
+		/// The functions live in this event's own buffer, a copy would allocate them from the default resource instead.
+		InlineEvent(const InlineEvent&) = delete;
+		InlineEvent& operator =(const InlineEvent&) = delete;
+
+		/// Shrinking would give back the inline block, which only ever gets handed out again to the very first function.
+		void ShrinkToFit() = delete;
+
+		static constexpr std::size_t GetInlineCapacity()
+		{
+			return InlineCount;
+		}
+	};
+}
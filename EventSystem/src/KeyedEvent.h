@@ -0,0 +1,257 @@
+#pragma once
+#include "Event.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Events
+{
+	///<summary>
+	///Event whose first argument is a key, eg. the id of the entity it's about, and whose functions can be bound to a single key.
+	///Firing looks the key up in a hash map and only calls the functions bound to it, so it costs as much as the matching
+	///functions do, however many other keys have some. Functions can still be bound to every key: those run after the keyed ones.
+	///Every key gets an Event of its own, so functions bound to the same key run in priority, then bind order, like on an Event.
+	///</summary>
+	template<typename... Args>
+	class KeyedEvent
+	{
+		static_assert(sizeof...(Args) > 0, "The first argument of a KeyedEvent is its key.");
+
+	public:
+		using KeyType = std::decay_t<std::tuple_element_t<0, std::tuple<Args...>>>;
+
+	private:
+		///<summary>
+		///Functions of a single key. Subscriptions it hands out, tracked callers included, unbind through the KeyedEvent,
+		///so the key goes away along with its last function.
+		///</summary>
+		struct KeyBucket : Event<Args...>
+		{
+			KeyedEvent& owner;
+			/// Key of the map node holding this bucket, set right after the node is created.
+			const KeyType* key = nullptr;
+
+			KeyBucket(std::pmr::memory_resource* resource, KeyedEvent& owner) : Event<Args...>(resource), owner(owner)
+			{
+				this->RouteSubscriptions(&UnbindFromOwner);
+			}
+
+			static void UnbindFromOwner(void* event, ListenerHandle handle)
+			{
+				KeyBucket& bucket = static_cast<KeyBucket&>(*static_cast<BasicEvent<void, Args...>*>(event));
+				bucket.owner.Unbind(*bucket.key, handle);
+			}
+		};
+
+		/// Functions bound to every key.
+		Event<Args...> anyKey;
+		std::pmr::unordered_map<KeyType, KeyBucket> byKey;
+		std::uint32_t dispatchDepth = 0;
+		/// Keys that lost their last function while the event was firing, dropped once the outermost fire is over.
+		std::pmr::vector<KeyType> emptiedKeys;
+		/// Whether every key was unbound while the event was firing, in which case every empty key is dropped.
+		bool emptiedAll = false;
+
+		struct DispatchScope
+		{
+			KeyedEvent& event;
+
+			explicit DispatchScope(KeyedEvent& event) : event(event)
+			{
+				++event.dispatchDepth;
+			}
+
+			~DispatchScope()
+			{
+				if (--event.dispatchDepth == 0 && (event.emptiedAll || !event.emptiedKeys.empty()))
+				{
+					event.DropEmptiedKeys();
+				}
+			}
+		};
+
+		void DropEmptiedKeys()
+		{
+			if (emptiedAll)
+			{
+				for (auto keyed = byKey.begin(); keyed != byKey.end();)
+				{
+					keyed = keyed->second.ListenerCount() == 0 ? byKey.erase(keyed) : std::next(keyed);
+				}
+			}
+			else
+			{
+				for (const KeyType& key : emptiedKeys)
+				{
+					auto found = byKey.find(key);
+					if (found != byKey.end() && found->second.ListenerCount() == 0)
+					{
+						byKey.erase(found);
+					}
+				}
+			}
+			emptiedKeys.clear();
+			emptiedAll = false;
+		}
+
+		template<typename FirstArg, typename ...OtherArgs>
+		static const FirstArg& KeyOf(const FirstArg& key, const OtherArgs& ...)
+		{
+			return key;
+		}
+
+	public:
+		KeyedEvent() : KeyedEvent(std::pmr::get_default_resource()) { }
+
+		///<summary>
+		///Creates an event that takes all of its memory from the given resource, which must outlive the event.
+		///</summary>
+		explicit KeyedEvent(std::pmr::memory_resource* resource) : anyKey(resource), byKey(resource), emptiedKeys(resource) { }
+
+		KeyedEvent(const KeyedEvent&) = delete;
+		KeyedEvent& operator =(const KeyedEvent&) = delete;
+
+		///<summary>
+		///Binds a function to every key, taking the same arguments as Event::Bind.
+		///</summary>
+		template<typename ...BindArgs>
+		ListenerHandle Bind(BindArgs&& ...bindArgs)
+		{
+			return anyKey.Bind(std::forward<BindArgs>(bindArgs)...);
+		}
+
+		///<summary>
+		///Binds a function to the given key only, taking the same arguments as Event::Bind after the key.
+		///The returned handle only means something together with its key, see Unbind.
+		///</summary>
+		template<typename ...BindArgs>
+		ListenerHandle BindKeyed(const KeyType& key, BindArgs&& ...bindArgs)
+		{
+			auto keyed = byKey.try_emplace(key, byKey.get_allocator().resource(), *this).first;
+			keyed->second.key = &keyed->first;
+			return keyed->second.Bind(std::forward<BindArgs>(bindArgs)...);
+		}
+
+		void Unbind(ListenerHandle handle)
+		{
+			anyKey.Unbind(handle);
+		}
+
+		///<summary>
+		///Removes a function bound to the given key. Keys left without functions are dropped, right away or, if the event is
+		///firing, once the outermost fire is over.
+		///</summary>
+		void Unbind(const KeyType& key, ListenerHandle handle)
+		{
+			auto found = byKey.find(key);
+			if (found == byKey.end())
+			{
+				return;
+			}
+
+			found->second.Unbind(handle);
+			if (found->second.ListenerCount() == 0)
+			{
+				if (dispatchDepth == 0)
+				{
+					byKey.erase(found);
+				}
+				else
+				{
+					//Subscriptions unbind through here from their destructor and move assignment, which must not throw.
+					try
+					{
+						emptiedKeys.push_back(key);
+					}
+					catch (...)
+					{
+						emptiedAll = true;
+					}
+				}
+			}
+		}
+
+		///<summary>
+		///Event holding the functions of the given key, eg. to Subscribe to it or to co_await its next fire, or nullptr if none
+		///were ever bound to it. Only valid until the last function of that key is unbound. Subscriptions it hands out unbind
+		///through this event, but functions unbound straight from it leave their key behind until the next Unbind for it.
+		///</summary>
+		Event<Args...>* Find(const KeyType& key)
+		{
+			auto found = byKey.find(key);
+			return found != byKey.end() ? &found->second : nullptr;
+		}
+
+		Event<Args...>& AnyKey()
+		{
+			return anyKey;
+		}
+
+		///<summary>
+		///Calls the functions bound to the key given as first argument, then the ones bound to every key. Arguments are handed
+		///over like Event does: only the very last function receives rvalues as they were passed in.
+		///</summary>
+		void operator() (Args&& ... args)
+		{
+			DispatchScope scope(*this);
+			auto found = byKey.find(KeyOf(args...));
+			if (found == byKey.end())
+			{
+				anyKey(std::forward<Args>(args)...);
+			}
+			else if (anyKey.ListenerCount() == 0)
+			{
+				found->second(std::forward<Args>(args)...);
+			}
+			else
+			{
+				found->second.Broadcast(args...);
+				anyKey(std::forward<Args>(args)...);
+			}
+		}
+
+		void UnbindAll()
+		{
+			anyKey.UnbindAll();
+			if (dispatchDepth == 0)
+			{
+				byKey.clear();
+			}
+			else
+			{
+				for (auto& keyed : byKey)
+				{
+					keyed.second.UnbindAll();
+				}
+				emptiedAll = true;
+			}
+		}
+
+		///<summary>
+		///Amount of keys with functions bound to them.
+		///</summary>
+		std::size_t KeyCount() const
+		{
+			return byKey.size();
+		}
+
+		///<summary>
+		///Amount of functions bound, to every key and to single ones. Has to visit every key.
+		///</summary>
+		std::size_t ListenerCount() const
+		{
+			std::size_t count = anyKey.ListenerCount();
+			for (const auto& keyed : byKey)
+			{
+				count += keyed.second.ListenerCount();
+			}
+			return count;
+		}
+	};
+}
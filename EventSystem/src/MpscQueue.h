@@ -0,0 +1,174 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace Events
+{
+	///<summary>
+	///Fixed-capacity FIFO queue any amount of threads can push to while a single thread pops from it, without locks.
+	///Every slot has a sequence number telling whether it's free, being written or ready, so producers only ever contend
+	///on the index of the next slot. All of its memory is allocated up front, pushing and popping never allocate.
+	///</summary>
+	template<typename ValueType>
+	class MpscQueue
+	{
+	private:
+		static constexpr std::size_t CacheLineSize = 64;
+
+		struct Slot
+		{
+			std::atomic<std::size_t> sequence;
+			/// False for a slot whose value threw while being constructed, which the consumer steps over.
+			bool hasValue;
+			alignas(ValueType) unsigned char bytes[sizeof(ValueType)];
+
+			ValueType* Value()
+			{
+				return std::launder(reinterpret_cast<ValueType*>(bytes));
+			}
+		};
+
+		static std::size_t RoundUpToPowerOfTwo(std::size_t value)
+		{
+			std::size_t power = 1;
+			while (power < value)
+			{
+				power <<= 1;
+			}
+			return power;
+		}
+
+		/// Hands the slot at the front back to producers, for the next lap.
+		void Release(Slot& slot)
+		{
+			slot.sequence.store(dequeuePosition + mask + 1, std::memory_order_release);
+			++dequeuePosition;
+		}
+
+		std::unique_ptr<Slot[]> slots;
+		const std::size_t mask;
+		/// Producers and the consumer each get their own cache line, so pushing doesn't slow down popping.
+		alignas(CacheLineSize) std::atomic<std::size_t> enqueuePosition{ 0 };
+		alignas(CacheLineSize) std::size_t dequeuePosition = 0;
+
+	public:
+		///<summary>
+		///Creates a queue able to hold at least the given amount of values. The capacity is rounded up to a power of two.
+		///</summary>
+		explicit MpscQueue(std::size_t capacity) :
+			slots(std::make_unique<Slot[]>(RoundUpToPowerOfTwo(capacity))), mask(RoundUpToPowerOfTwo(capacity) - 1)
+		{
+			for (std::size_t i = 0; i <= mask; ++i)
+			{
+				slots[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		MpscQueue(const MpscQueue&) = delete;
+		MpscQueue& operator =(const MpscQueue&) = delete;
+
+		~MpscQueue()
+		{
+			while (Front() != nullptr)
+			{
+				PopFront();
+			}
+		}
+
+		///<summary>
+		///Constructs a new value at the back of the queue. Safe to call from any thread.
+		///Returns false, and constructs nothing, if the queue is full. If constructing the value throws, the exception is
+		///passed on and the consumer skips the slot.
+		///</summary>
+		template<typename ...ConstructorArgs>
+		bool Emplace(ConstructorArgs&& ...constructorArgs)
+		{
+			std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+			Slot* slot;
+			while (true)
+			{
+				slot = &slots[position & mask];
+				const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+				const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+				if (difference == 0)
+				{
+					if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (difference < 0)
+				{
+					//The consumer hasn't freed this slot since the last lap.
+					return false;
+				}
+				else
+				{
+					position = enqueuePosition.load(std::memory_order_relaxed);
+				}
+			}
+
+			//The slot is claimed already and the consumer waits for it in order, so it gets published whatever happens.
+			try
+			{
+				new (slot->bytes) ValueType(std::forward<ConstructorArgs>(constructorArgs)...);
+			}
+			catch (...)
+			{
+				slot->hasValue = false;
+				slot->sequence.store(position + 1, std::memory_order_release);
+				throw;
+			}
+			slot->hasValue = true;
+			slot->sequence.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+		///<summary>
+		///Oldest value of the queue, or nullptr if it's empty or the oldest value is still being written.
+		///Must only be called from the consuming thread.
+		///</summary>
+		ValueType* Front()
+		{
+			while (true)
+			{
+				Slot& slot = slots[dequeuePosition & mask];
+				if (slot.sequence.load(std::memory_order_acquire) != dequeuePosition + 1)
+				{
+					return nullptr;
+				}
+				if (slot.hasValue)
+				{
+					return slot.Value();
+				}
+				Release(slot);
+			}
+		}
+
+		///<summary>
+		///Destroys the value returned by Front and frees its slot for producers. Must only be called from the consuming thread.
+		///</summary>
+		void PopFront()
+		{
+			Slot& slot = slots[dequeuePosition & mask];
+			slot.Value()->~ValueType();
+			Release(slot);
+		}
+
+		std::size_t Capacity() const
+		{
+			return mask + 1;
+		}
+
+		///<summary>
+		///Amount of values pushed but not popped yet. Only a snapshot while producers keep pushing.
+		///</summary>
+		std::size_t ApproximateSize() const
+		{
+			return enqueuePosition.load(std::memory_order_relaxed) - dequeuePosition;
+		}
+	};
+}
@@ -0,0 +1,210 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace Events
+{
+	template<typename ValueType>
+	class PayloadPool;
+
+	///<summary>
+	///Shared reference to a value of a PayloadPool, the pooled counterpart of a std::shared_ptr. Copying it only bumps a
+	///reference count, so an Event<PooledPayload<Packet>> hands the same packet to every listener, queue or thread without
+	///copying it. The value goes back to the pool once the last copy is destroyed.
+	///Copies can be used from any thread. The value itself isn't synchronized: fill it in before sharing it, read it after.
+	///Events that take it as a const reference, eg. a QueuedEvent<const PooledPayload<Packet>&>, still keep their own copy
+	///of the handle but pass that to every listener as is, without touching the count at all.
+	///</summary>
+	template<typename ValueType>
+	class PooledPayload
+	{
+		friend class PayloadPool<ValueType>;
+
+	private:
+		PayloadPool<ValueType>* pool = nullptr;
+		std::uint32_t index = 0;
+
+		PooledPayload(PayloadPool<ValueType>& pool, std::uint32_t index) : pool(&pool), index(index) { }
+
+	public:
+		PooledPayload() = default;
+
+		PooledPayload(const PooledPayload& other) : pool(other.pool), index(other.index)
+		{
+			if (pool != nullptr)
+			{
+				pool->AddReference(index);
+			}
+		}
+
+		PooledPayload(PooledPayload&& other) noexcept : pool(std::exchange(other.pool, nullptr)), index(other.index) { }
+
+		PooledPayload& operator =(PooledPayload other) noexcept
+		{
+			std::swap(pool, other.pool);
+			std::swap(index, other.index);
+			return *this;
+		}
+
+		~PooledPayload()
+		{
+			Reset();
+		}
+
+		///<summary>
+		///Lets go of the value, returning it to the pool if this was the last reference to it.
+		///</summary>
+		void Reset()
+		{
+			if (pool != nullptr)
+			{
+				std::exchange(pool, nullptr)->RemoveReference(index);
+			}
+		}
+
+		explicit operator bool() const
+		{
+			return pool != nullptr;
+		}
+
+		ValueType& operator*() const
+		{
+			return pool->ValueAt(index);
+		}
+
+		ValueType* operator->() const
+		{
+			return &pool->ValueAt(index);
+		}
+
+		ValueType* Get() const
+		{
+			return pool != nullptr ? &pool->ValueAt(index) : nullptr;
+		}
+	};
+
+	///<summary>
+	///Fixed set of values handed out as PooledPayloads, meant for big event payloads such as network packets. Every value is
+	///created up front and reused as is: a value comes back out of the pool the way its last user left it, so a
+	///std::vector payload keeps its capacity, and acquiring or releasing one never allocates.
+	///Values can be acquired and released from any thread without locks. The pool must outlive every payload it handed out.
+	///</summary>
+	template<typename ValueType>
+	class PayloadPool
+	{
+		friend class PooledPayload<ValueType>;
+
+	private:
+		static constexpr std::size_t CacheLineSize = 64;
+		static constexpr std::uint32_t NoSlot = 0xFFFFFFFFu;
+
+		/// Each slot on its own cache line, so threads releasing different payloads don't contend on their counts.
+		struct alignas(CacheLineSize) Slot
+		{
+			std::atomic<std::uint32_t> references{ 0 };
+			/// Next free slot while this one is free. Atomic, since a thread may read it while another takes the slot.
+			std::atomic<std::uint32_t> next{ NoSlot };
+			ValueType value;
+		};
+
+		std::unique_ptr<Slot[]> slots;
+		const std::uint32_t capacity;
+		/// Head of the free list in the low half, and a version in the high half that changes on every update,
+		/// so a slot taken and put back meanwhile can't be mistaken for an unchanged head.
+		alignas(CacheLineSize) std::atomic<std::uint64_t> freeHead;
+		std::atomic<std::uint32_t> freeCount;
+
+		static std::uint64_t Pack(std::uint32_t index, std::uint64_t version)
+		{
+			return (version << 32) | index;
+		}
+
+		ValueType& ValueAt(std::uint32_t index) const
+		{
+			return slots[index].value;
+		}
+
+		void AddReference(std::uint32_t index)
+		{
+			slots[index].references.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		void RemoveReference(std::uint32_t index)
+		{
+			//Acquire-release, so the last user sees every write made through the other references before the slot is reused.
+			if (slots[index].references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				Release(index);
+			}
+		}
+
+		void Release(std::uint32_t index)
+		{
+			std::uint64_t head = freeHead.load(std::memory_order_relaxed);
+			do
+			{
+				slots[index].next.store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+			}
+			while (!freeHead.compare_exchange_weak(head, Pack(index, (head >> 32) + 1), std::memory_order_release, std::memory_order_relaxed));
+			freeCount.fetch_add(1, std::memory_order_relaxed);
+		}
+
+	public:
+		///<summary>
+		///Creates the given amount of values, each constructed from the given arguments, eg. a reserved buffer size.
+		///</summary>
+		template<typename ...ValueArgs>
+		explicit PayloadPool(std::size_t capacity, const ValueArgs& ...valueArgs) :
+			slots(std::make_unique<Slot[]>(capacity)), capacity(static_cast<std::uint32_t>(capacity)),
+			freeHead(Pack(capacity > 0 ? 0 : NoSlot, 0)), freeCount(static_cast<std::uint32_t>(capacity))
+		{
+			for (std::uint32_t i = 0; i < this->capacity; ++i)
+			{
+				if constexpr (sizeof...(ValueArgs) > 0)
+				{
+					slots[i].value = ValueType(valueArgs...);
+				}
+				slots[i].next.store(i + 1 < this->capacity ? i + 1 : NoSlot, std::memory_order_relaxed);
+			}
+		}
+
+		PayloadPool(const PayloadPool&) = delete;
+		PayloadPool& operator =(const PayloadPool&) = delete;
+
+		///<summary>
+		///Takes a free value out of the pool, or returns an empty payload if every value is in use.
+		///</summary>
+		PooledPayload<ValueType> Acquire()
+		{
+			std::uint64_t head = freeHead.load(std::memory_order_acquire);
+			while (static_cast<std::uint32_t>(head) != NoSlot)
+			{
+				const std::uint32_t index = static_cast<std::uint32_t>(head);
+				const std::uint32_t next = slots[index].next.load(std::memory_order_relaxed);
+				if (freeHead.compare_exchange_weak(head, Pack(next, (head >> 32) + 1), std::memory_order_acquire, std::memory_order_acquire))
+				{
+					freeCount.fetch_sub(1, std::memory_order_relaxed);
+					slots[index].references.store(1, std::memory_order_relaxed);
+					return PooledPayload<ValueType>(*this, index);
+				}
+			}
+			return PooledPayload<ValueType>();
+		}
+
+		std::size_t Capacity() const
+		{
+			return capacity;
+		}
+
+		///<summary>
+		///Amount of values not in use right now. Only a snapshot while other threads acquire or release values.
+		///</summary>
+		std::size_t FreeCount() const
+		{
+			return freeCount.load(std::memory_order_relaxed);
+		}
+	};
+}
@@ -0,0 +1,122 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+///<summary>
+///Instrumentation of event fires, compiled out unless EVENTSYSTEM_PROFILING is defined to 1 before including any header.
+///With it, every event records how often and how long it fires, see BasicEvent::GetStats. Defining EVENTSYSTEM_PROFILE_LISTENERS
+///to 1 as well also times every single function call, see BasicEvent::GetListenerStats, at the cost of two clock reads per call.
+///</summary>
+#ifndef EVENTSYSTEM_PROFILING
+#define EVENTSYSTEM_PROFILING 0
+#endif
+
+#ifndef EVENTSYSTEM_PROFILE_LISTENERS
+#define EVENTSYSTEM_PROFILE_LISTENERS 0
+#endif
+
+#if EVENTSYSTEM_PROFILE_LISTENERS && !EVENTSYSTEM_PROFILING
+#error EVENTSYSTEM_PROFILE_LISTENERS needs EVENTSYSTEM_PROFILING
+#endif
+
+///<summary>
+///Hooks for an external profiler, opened as a scope around every fire of an event, named after its debug name, and around
+///every function call when listeners are profiled. Both expand to nothing unless defined before including any header,
+///eg. for Tracy:
+///  #define EVENTSYSTEM_PROFILE_ZONE(name) ZoneScoped; ZoneName(name, std::strlen(name))
+///  #define EVENTSYSTEM_PROFILE_LISTENER_ZONE() ZoneScopedN("Listener")
+///</summary>
+#ifndef EVENTSYSTEM_PROFILE_ZONE
+#define EVENTSYSTEM_PROFILE_ZONE(name)
+#endif
+
+#ifndef EVENTSYSTEM_PROFILE_LISTENER_ZONE
+#define EVENTSYSTEM_PROFILE_LISTENER_ZONE()
+#endif
+
+namespace Events
+{
+	///<summary>
+	///What an event recorded about its fires since it was created or its stats were last reset. All zeros when profiling is off.
+	///</summary>
+	struct EventStats
+	{
+		std::uint64_t fireCount = 0;
+		/// Amount of functions bound during the most recent fire.
+		std::uint64_t listenerCount = 0;
+		std::uint64_t totalNanoseconds = 0;
+		std::uint64_t maxNanoseconds = 0;
+	};
+
+	///<summary>
+	///What an event recorded about the calls to a single one of its functions. All zeros unless listeners are profiled.
+	///</summary>
+	struct ListenerStats
+	{
+		std::uint64_t callCount = 0;
+		std::uint64_t totalNanoseconds = 0;
+		std::uint64_t maxNanoseconds = 0;
+	};
+
+	///<summary>
+	///Measures the time between its construction and its destruction.
+	///</summary>
+	class ScopeTimer
+	{
+	private:
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	public:
+		std::uint64_t ElapsedNanoseconds() const
+		{
+			return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+		}
+	};
+
+	///<summary>
+	///Event currently walking its functions on the calling thread, which the time spent in each function is reported to.
+	///Set by the event for the duration of a fire, and only used when listeners are profiled.
+	///</summary>
+	struct ListenerRecorder
+	{
+		const void* first = nullptr;
+		const void* last = nullptr;
+		void* event = nullptr;
+		void(*record)(void* event, const void* listener, std::uint64_t nanoseconds) = nullptr;
+
+		static ListenerRecorder*& Current()
+		{
+			thread_local ListenerRecorder* current = nullptr;
+			return current;
+		}
+
+		/// Whether the given listener is one of the recording event's, rather than one of an event that doesn't record.
+		bool Owns(const void* listener) const
+		{
+			return !std::less<const void*>()(listener, first) && std::less<const void*>()(listener, last);
+		}
+	};
+
+	///<summary>
+	///Times a single function call, and reports it to the current recorder once done.
+	///</summary>
+	class ListenerTimer
+	{
+	private:
+		const void* listener;
+		ListenerRecorder* recorder = ListenerRecorder::Current();
+		ScopeTimer timer;
+
+	public:
+		explicit ListenerTimer(const void* listener) : listener(listener) { }
+
+		~ListenerTimer()
+		{
+			if (recorder != nullptr && recorder->Owns(listener))
+			{
+				recorder->record(recorder->event, listener, timer.ElapsedNanoseconds());
+			}
+		}
+	};
+}
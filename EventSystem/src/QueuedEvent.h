@@ -0,0 +1,90 @@
+#pragma once
+#include "DeferredEvent.h"
+#include "RingBuffer.h"
+
+#include <cstddef>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Events
+{
+	///<summary>
+	///Event whose firing is deferred: operator() only copies the arguments into a preallocated queue, and the bound functions
+	///run later, in a single batch, when Dispatch or Drain is called. Functions are bound and unbound just like on an Event.
+	///Listeners always receive the queued copies, also for reference arguments.
+	///</summary>
+	template<typename... Args>
+	class QueuedEvent : public DeferredEvent<Args...>
+	{
+	public:
+		using Payload = typename DeferredEvent<Args...>::Payload;
+
+	private:
+		RingBuffer<Payload> pending;
+
+	public:
+		///<summary>
+		///Creates an event able to hold up to the given amount of pending payloads.
+		///</summary>
+		explicit QueuedEvent(std::size_t capacity) : pending(capacity) { }
+
+		///<summary>
+		///Same as above, with the bound functions stored in the given memory resource. The queue itself is still allocated up front.
+		///</summary>
+		QueuedEvent(std::size_t capacity, std::pmr::memory_resource* resource) : DeferredEvent<Args...>(resource), pending(capacity) { }
+
+		///<summary>
+		///Queues the given arguments without calling anything. Returns false, dropping the arguments, if the queue is full.
+		///</summary>
+		bool operator() (Args&& ... args)
+		{
+			return pending.Emplace(std::forward<Args>(args)...);
+		}
+
+		///<summary>
+		///Delivers every payload that was pending when called. Payloads queued by the functions themselves wait for the next call.
+		///Returns the amount of payloads delivered.
+		///</summary>
+		std::size_t Dispatch()
+		{
+			return Drain(pending.Size());
+		}
+
+		///<summary>
+		///Delivers up to the given amount of pending payloads, oldest first. Returns the amount of payloads delivered.
+		///</summary>
+		std::size_t Drain(std::size_t maxCount)
+		{
+			std::size_t delivered = 0;
+			while (delivered < maxCount && !pending.IsEmpty())
+			{
+				//Taken out of the queue first, so functions that fire or drain this event again never see it twice.
+				Payload payload(std::move(pending.Front()));
+				pending.PopFront();
+				this->Deliver(payload);
+				++delivered;
+			}
+			return delivered;
+		}
+
+		///<summary>
+		///Drops every pending payload without delivering it.
+		///</summary>
+		void ClearPending()
+		{
+			pending.Clear();
+		}
+
+		std::size_t PendingCount() const
+		{
+			return pending.Size();
+		}
+
+		std::size_t PendingCapacity() const
+		{
+			return pending.Capacity();
+		}
+	};
+}
@@ -0,0 +1,153 @@
+#pragma once
+#include "Event.h"
+
+#include <limits>
+#include <memory_resource>
+#include <utility>
+
+namespace Events
+{
+	///<summary>
+	///Adds up every result. Starts at a value-initialized ValueType, so an event with no functions returns zero.
+	///</summary>
+	template<typename ValueType>
+	struct Sum
+	{
+		using ResultType = ValueType;
+
+		ValueType Initial() const
+		{
+			return ValueType();
+		}
+
+		void operator()(ValueType& total, ValueType value) const
+		{
+			total += value;
+		}
+	};
+
+	///<summary>
+	///Keeps the smallest result. An event with no functions returns the highest value a ValueType can hold.
+	///</summary>
+	template<typename ValueType>
+	struct Min
+	{
+		using ResultType = ValueType;
+
+		ValueType Initial() const
+		{
+			return std::numeric_limits<ValueType>::max();
+		}
+
+		void operator()(ValueType& smallest, ValueType value) const
+		{
+			if (value < smallest)
+			{
+				smallest = value;
+			}
+		}
+	};
+
+	///<summary>
+	///Keeps the biggest result. An event with no functions returns the lowest value a ValueType can hold.
+	///</summary>
+	template<typename ValueType>
+	struct Max
+	{
+		using ResultType = ValueType;
+
+		ValueType Initial() const
+		{
+			return std::numeric_limits<ValueType>::lowest();
+		}
+
+		void operator()(ValueType& biggest, ValueType value) const
+		{
+			if (biggest < value)
+			{
+				biggest = value;
+			}
+		}
+	};
+
+	///<summary>
+	///Whether any function returned true, eg. to ask if anything vetoes an action. False with no functions.
+	///</summary>
+	struct Any
+	{
+		using ResultType = bool;
+
+		bool Initial() const
+		{
+			return false;
+		}
+
+		void operator()(bool& any, bool value) const
+		{
+			any = any || value;
+		}
+	};
+
+	///<summary>
+	///Whether every function returned true. True with no functions.
+	///</summary>
+	struct All
+	{
+		using ResultType = bool;
+
+		bool Initial() const
+		{
+			return true;
+		}
+
+		void operator()(bool& all, bool value) const
+		{
+			all = all && value;
+		}
+	};
+
+	///<summary>
+	///Event whose functions return a value, folded into a single result while firing, without collecting them anywhere.
+	///The reducer decides how: Sum, Min, Max, Any, All, or any type with the same members, ie. a ResultType that every
+	///function returns, an Initial() result and an operator() that folds one more result into the current one.
+	///Every function is called, in priority order, same as with Event.
+	///</summary>
+	template<typename Reducer, typename... Args>
+	class ReducingEvent : public BasicEvent<typename Reducer::ResultType, Args...>
+	{
+	public:
+		using ResultType = typename Reducer::ResultType;
+
+	private:
+		Reducer reducer;
+
+	public:
+		explicit ReducingEvent(Reducer reducer = Reducer()) : reducer(std::move(reducer)) { }
+
+		ReducingEvent(Reducer reducer, std::pmr::memory_resource* resource) :
+			BasicEvent<ResultType, Args...>(resource), reducer(std::move(reducer)) { }
+
+		///<summary>
+		///Calls every bound function and returns their folded results. Arguments are handed over the same way Event does.
+		///</summary>
+		ResultType operator() (Args&& ... args)
+		{
+			return this->CallBound([&](const Listener<ResultType, Args...>* first, const Listener<ResultType, Args...>* last)
+				{ return Listener<ResultType, Args...>::Reduce(first, last, reducer, reducer.Initial(), std::forward<Args>(args)...); });
+		}
+
+		///<summary>
+		///Same as operator(), without ever moving from the given arguments.
+		///</summary>
+		ResultType Broadcast(const Args& ... args)
+		{
+			return this->CallBound([&](const Listener<ResultType, Args...>* first, const Listener<ResultType, Args...>* last)
+				{ return Listener<ResultType, Args...>::ReduceConst(first, last, reducer, reducer.Initial(), args...); });
+		}
+
+		const Reducer& GetReducer() const
+		{
+			return reducer;
+		}
+	};
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace Events
+{
+	///<summary>
+	///Fixed-capacity FIFO queue. All of its memory is allocated up front, so pushing and popping never allocate.
+	///</summary>
+	template<typename ValueType>
+	class RingBuffer
+	{
+	private:
+		struct Slot
+		{
+			alignas(ValueType) unsigned char bytes[sizeof(ValueType)];
+		};
+
+		std::unique_ptr<Slot[]> slots;
+		std::size_t capacity;
+		std::size_t head = 0;
+		std::size_t count = 0;
+
+		ValueType* At(std::size_t position) const
+		{
+			const std::size_t index = head + position < capacity ? head + position : head + position - capacity;
+			return std::launder(reinterpret_cast<ValueType*>(slots[index].bytes));
+		}
+
+	public:
+		explicit RingBuffer(std::size_t capacity) : slots(std::make_unique<Slot[]>(capacity)), capacity(capacity) { }
+
+		RingBuffer(const RingBuffer&) = delete;
+		RingBuffer& operator =(const RingBuffer&) = delete;
+
+		~RingBuffer()
+		{
+			Clear();
+		}
+
+		///<summary>
+		///Constructs a new value at the back of the queue. Returns false, and constructs nothing, if the queue is full.
+		///</summary>
+		template<typename ...ConstructorArgs>
+		bool Emplace(ConstructorArgs&& ...constructorArgs)
+		{
+			if (count == capacity)
+			{
+				return false;
+			}
+
+			const std::size_t index = head + count < capacity ? head + count : head + count - capacity;
+			new (slots[index].bytes) ValueType(std::forward<ConstructorArgs>(constructorArgs)...);
+			++count;
+			return true;
+		}
+
+		ValueType& Front()
+		{
+			return *At(0);
+		}
+
+		///<summary>
+		///Value at the given position, counting from the front of the queue.
+		///</summary>
+		ValueType& operator [](std::size_t position)
+		{
+			return *At(position);
+		}
+
+		void PopFront()
+		{
+			At(0)->~ValueType();
+			head = head + 1 < capacity ? head + 1 : 0;
+			--count;
+		}
+
+		void Clear()
+		{
+			while (count > 0)
+			{
+				PopFront();
+			}
+			head = 0;
+		}
+
+		std::size_t Size() const
+		{
+			return count;
+		}
+
+		std::size_t Capacity() const
+		{
+			return capacity;
+		}
+
+		bool IsEmpty() const
+		{
+			return count == 0;
+		}
+
+		bool IsFull() const
+		{
+			return count == capacity;
+		}
+	};
+}
@@ -0,0 +1,184 @@
+#pragma once
+#include "Event.h"
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Events
+{
+	/// Stands in for the caller of a global function, which has none.
+	struct NoCaller { };
+
+	///<summary>
+	///Describes a function that can be a listener of a StaticEvent: what it must be called with, and on what kind of object.
+	///Only defined for functions with no return value, just like the ones an Event can bind.
+	///</summary>
+	template<typename FunctionType>
+	struct StaticListenerTraits;
+
+	template<typename ...Args>
+	struct StaticListenerTraits<void(*)(Args...)>
+	{
+		using Signature = void(Args...);
+		using CallerPointer = NoCaller;
+		static constexpr bool IsMember = false;
+	};
+
+	template<typename CallerType, typename ...Args>
+	struct StaticListenerTraits<void(CallerType::*)(Args...)>
+	{
+		using Signature = void(Args...);
+		using CallerPointer = CallerType*;
+		static constexpr bool IsMember = true;
+	};
+
+	template<typename CallerType, typename ...Args>
+	struct StaticListenerTraits<void(CallerType::*)(Args...) const>
+	{
+		using Signature = void(Args...);
+		using CallerPointer = const CallerType*;
+		static constexpr bool IsMember = true;
+	};
+
+	template<auto Function, auto ...>
+	struct FirstStaticListener
+	{
+		using Signature = typename StaticListenerTraits<decltype(Function)>::Signature;
+	};
+
+	template<typename Signature, auto ...Functions>
+	class BasicStaticEvent;
+
+	///<summary>
+	///Event whose functions are fixed at compile time, given as template arguments, eg. StaticEvent<&OnHit, &Player::OnHit>.
+	///Firing it is a straight sequence of direct calls the compiler can inline, no slots, thunks or vtables involved.
+	///Fired exactly like an Event with the same arguments, so a type alias can switch an event between the two.
+	///The objects of member functions are passed to the constructor, in the same order as their functions.
+	///</summary>
+	template<auto ...Functions>
+	using StaticEvent = BasicStaticEvent<typename FirstStaticListener<Functions...>::Signature, Functions...>;
+
+	template<typename ...Args, auto ...Functions>
+	class BasicStaticEvent<void(Args...), Functions...>
+	{
+		static_assert((std::is_same<typename StaticListenerTraits<decltype(Functions)>::Signature, void(Args...)>::value && ...),
+			"Every function of a StaticEvent must take the same arguments.");
+
+	private:
+		template<std::size_t Index>
+		using Traits = StaticListenerTraits<std::tuple_element_t<Index, std::tuple<decltype(Functions)...>>>;
+
+		static constexpr std::size_t FunctionCount = sizeof...(Functions);
+		static constexpr bool IsMember[] = { StaticListenerTraits<decltype(Functions)>::IsMember... };
+
+		/// Position of the caller of the function at the given index among the constructor arguments.
+		static constexpr std::size_t CallerIndex(std::size_t functionIndex)
+		{
+			std::size_t index = 0;
+			for (std::size_t i = 0; i < functionIndex; ++i)
+			{
+				index += IsMember[i] ? 1 : 0;
+			}
+			return index;
+		}
+
+		static constexpr std::size_t CallerCount = CallerIndex(FunctionCount);
+
+		using CallerTuple = std::tuple<typename StaticListenerTraits<decltype(Functions)>::CallerPointer...>;
+		using FunctionTuple = std::tuple<decltype(Functions)...>;
+
+		CallerTuple callers;
+
+		template<std::size_t Index, typename CallerArgs>
+		static auto CallerAt(CallerArgs& callerArgs)
+		{
+			if constexpr (Traits<Index>::IsMember)
+			{
+				return typename Traits<Index>::CallerPointer(&std::get<CallerIndex(Index)>(callerArgs));
+			}
+			else
+			{
+				return NoCaller();
+			}
+		}
+
+		template<typename CallerArgs, std::size_t ...Indices>
+		static CallerTuple MakeCallers(CallerArgs&& callerArgs, std::index_sequence<Indices...>)
+		{
+			return CallerTuple(CallerAt<Indices>(callerArgs)...);
+		}
+
+		template<std::size_t Index, typename ...CallArgs>
+		void CallAt(CallArgs&& ...args) const
+		{
+			constexpr auto function = std::get<Index>(FunctionTuple(Functions...));
+			if constexpr (Traits<Index>::IsMember)
+			{
+				(std::get<Index>(callers)->*function)(std::forward<CallArgs>(args)...);
+			}
+			else
+			{
+				function(std::forward<CallArgs>(args)...);
+			}
+		}
+
+		/// Hands the arguments over to the last function, and copies of value arguments to every other one.
+		template<std::size_t Index>
+		void Deliver(Args& ...args) const
+		{
+			if constexpr (Index + 1 == FunctionCount)
+			{
+				CallAt<Index>(static_cast<Args&&>(args)...);
+			}
+			else
+			{
+				CallAt<Index>(static_cast<RepeatableArg<Args>>(args)...);
+			}
+		}
+
+		template<std::size_t ...Indices>
+		void DeliverAll(std::index_sequence<Indices...>, Args& ...args) const
+		{
+			(Deliver<Indices>(args...), ...);
+		}
+
+		template<std::size_t ...Indices>
+		void BroadcastAll(std::index_sequence<Indices...>, const Args& ...args) const
+		{
+			(CallAt<Indices>(static_cast<RepeatableArg<Args>>(args)...), ...);
+		}
+
+	public:
+		///<summary>
+		///Receives the object of every member function, in the order the member functions were given in.
+		///</summary>
+		template<typename ...Callers, typename = std::enable_if_t<
+			sizeof...(Callers) == CallerCount && (!std::is_same<std::remove_cv_t<Callers>, BasicStaticEvent>::value && ...)>>
+		explicit BasicStaticEvent(Callers& ...callerArgs) :
+			callers(MakeCallers(std::forward_as_tuple(callerArgs...), std::make_index_sequence<FunctionCount>())) { }
+
+		///<summary>
+		///Calls every function, in the order they were given in. When passing rvalues, only the last function receives them as is,
+		///every other one gets its own copy, the same as with Event.
+		///</summary>
+		void operator() (Args&& ... args) const
+		{
+			DeliverAll(std::make_index_sequence<FunctionCount>(), args...);
+		}
+
+		///<summary>
+		///Fires the event without moving from the given arguments. Every function taking a value argument gets its own copy.
+		///</summary>
+		void Broadcast(const Args& ... args) const
+		{
+			BroadcastAll(std::make_index_sequence<FunctionCount>(), args...);
+		}
+
+		static constexpr std::size_t Size()
+		{
+			return FunctionCount;
+		}
+	};
+}
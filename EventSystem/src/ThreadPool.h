@@ -0,0 +1,190 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Events
+{
+	///<summary>
+	///Fixed set of worker threads that run the chunks of one ParallelFor at a time, together with the thread that called it.
+	///Chunks are handed out one by one from a shared counter, so a thread that finishes early keeps taking work from the others.
+	///</summary>
+	class ThreadPool
+	{
+	private:
+		/// Type-erased body of the running ParallelFor, called with a [begin, end) range.
+		void(*run)(void* body, std::size_t begin, std::size_t end) = nullptr;
+		void* body = nullptr;
+		std::size_t count = 0;
+		std::size_t grainSize = 1;
+		std::size_t chunkCount = 0;
+		std::atomic<std::size_t> nextChunk{ 0 };
+
+		std::vector<std::thread> workers;
+		std::mutex stateMutex;
+		std::condition_variable workAvailable;
+		std::condition_variable workDone;
+		/// Bumped for every ParallelFor, so workers can tell a new job from the one they already ran. Guarded by stateMutex.
+		std::uint64_t generation = 0;
+		/// Workers that haven't finished the current job yet. Guarded by stateMutex.
+		std::size_t busyWorkers = 0;
+		/// First exception thrown by a chunk of the current job, rethrown by ParallelFor. Guarded by stateMutex.
+		std::exception_ptr failure;
+		bool stopping = false;
+		/// Only one ParallelFor runs at a time.
+		std::mutex jobMutex;
+
+		/// Pool the calling thread is running chunks for, if any.
+		static ThreadPool*& CurrentPool()
+		{
+			thread_local ThreadPool* pool = nullptr;
+			return pool;
+		}
+
+		template<typename BodyType>
+		static void Run(void* body, std::size_t begin, std::size_t end)
+		{
+			(*static_cast<BodyType*>(body))(begin, end);
+		}
+
+		void RunChunks()
+		{
+			ThreadPool* previous = CurrentPool();
+			CurrentPool() = this;
+			for (std::size_t chunk = nextChunk.fetch_add(1); chunk < chunkCount; chunk = nextChunk.fetch_add(1))
+			{
+				const std::size_t begin = chunk * grainSize;
+				try
+				{
+					run(body, begin, std::min(begin + grainSize, count));
+				}
+				catch (...)
+				{
+					//The job failed, the chunks nobody took yet are skipped.
+					nextChunk.store(chunkCount);
+					std::lock_guard<std::mutex> lock(stateMutex);
+					if (failure == nullptr)
+					{
+						failure = std::current_exception();
+					}
+				}
+			}
+			CurrentPool() = previous;
+		}
+
+		void WorkerLoop()
+		{
+			std::uint64_t seenGeneration = 0;
+			while (true)
+			{
+				{
+					std::unique_lock<std::mutex> lock(stateMutex);
+					workAvailable.wait(lock, [&] { return stopping || generation != seenGeneration; });
+					if (stopping)
+					{
+						return;
+					}
+					seenGeneration = generation;
+				}
+
+				RunChunks();
+
+				std::lock_guard<std::mutex> lock(stateMutex);
+				if (--busyWorkers == 0)
+				{
+					workDone.notify_one();
+				}
+			}
+		}
+
+	public:
+		///<summary>
+		///Starts the given amount of worker threads. The thread calling ParallelFor works too, so the default leaves one
+		///hardware thread for it.
+		///</summary>
+		explicit ThreadPool(std::size_t threadCount = std::max(std::thread::hardware_concurrency(), 1u) - 1)
+		{
+			workers.reserve(threadCount);
+			for (std::size_t i = 0; i < threadCount; ++i)
+			{
+				workers.emplace_back([this] { WorkerLoop(); });
+			}
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator =(const ThreadPool&) = delete;
+
+		~ThreadPool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(stateMutex);
+				stopping = true;
+			}
+			workAvailable.notify_all();
+			for (auto& worker : workers)
+			{
+				worker.join();
+			}
+		}
+
+		///<summary>
+		///Calls the given body with consecutive [begin, end) ranges of at most grainSize indices, covering [0, count),
+		///spread over the workers and the calling thread. Returns once every range is done.
+		///If a range throws, the ranges not started yet are skipped, and the first exception is rethrown on the calling thread
+		///once the ranges already running are done.
+		///Calls made from inside a body of this pool run on the calling thread alone, instead of waiting on themselves.
+		///</summary>
+		template<typename BodyType>
+		void ParallelFor(std::size_t count, std::size_t grainSize, BodyType&& Body)
+		{
+			grainSize = std::max<std::size_t>(grainSize, 1);
+			//Not worth waking anyone for a single chunk.
+			if (count <= grainSize || workers.empty() || CurrentPool() == this)
+			{
+				for (std::size_t begin = 0; begin < count; begin += grainSize)
+				{
+					Body(begin, std::min(begin + grainSize, count));
+				}
+				return;
+			}
+
+			std::lock_guard<std::mutex> job(jobMutex);
+			{
+				std::lock_guard<std::mutex> lock(stateMutex);
+				run = &Run<std::remove_reference_t<BodyType>>;
+				body = const_cast<void*>(static_cast<const void*>(&Body));
+				this->count = count;
+				this->grainSize = grainSize;
+				chunkCount = (count + grainSize - 1) / grainSize;
+				nextChunk.store(0);
+				busyWorkers = workers.size();
+				++generation;
+			}
+			workAvailable.notify_all();
+
+			RunChunks();
+
+			std::unique_lock<std::mutex> lock(stateMutex);
+			workDone.wait(lock, [&] { return busyWorkers == 0; });
+			if (failure != nullptr)
+			{
+				std::exception_ptr rethrown = std::exchange(failure, nullptr);
+				lock.unlock();
+				std::rethrow_exception(rethrown);
+			}
+		}
+
+		std::size_t ThreadCount() const
+		{
+			return workers.size();
+		}
+	};
+}
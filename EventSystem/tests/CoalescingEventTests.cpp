@@ -0,0 +1,67 @@
+#include "TestHarness.h"
+#include "CoalescingEvent.h"
+
+#include <utility>
+#include <vector>
+
+using namespace Events;
+
+EVENTSYSTEM_TEST(CoalescingEventDeliversOnlyTheLatest)
+{
+	CoalescingEvent<int> event;
+	std::vector<int> received;
+	event.Bind([&received](int value) { received.push_back(value); });
+
+	CHECK(!event.Dispatch());
+	CHECK(!event(1));
+	CHECK(event(2));
+	CHECK(event(3));
+	CHECK(received.empty());
+	CHECK(event.HasPending());
+
+	CHECK(event.Dispatch());
+	CHECK((received == std::vector<int>{ 3 }));
+	CHECK(!event.HasPending());
+	CHECK(!event.Dispatch());
+}
+
+EVENTSYSTEM_TEST(CoalescingEventFiredDuringDispatchWaitsForTheNextOne)
+{
+	CoalescingEvent<int> event;
+	std::vector<int> received;
+	event.Bind([&](int value)
+		{
+			received.push_back(value);
+			event(value + 1);
+		});
+
+	event(1);
+	event.Dispatch();
+	event.Dispatch();
+	CHECK((received == std::vector<int>{ 1, 2 }));
+
+	event.ClearPending();
+	CHECK(!event.Dispatch());
+}
+
+EVENTSYSTEM_TEST(KeyedCoalescingEventKeepsTheLatestPerKey)
+{
+	KeyedCoalescingEvent<int, int> event;
+	std::vector<std::pair<int, int>> received;
+	event.Bind([&received](int key, int value) { received.emplace_back(key, value); });
+
+	CHECK(!event(7, 1));
+	CHECK(!event(3, 1));
+	CHECK(event(7, 2));
+	CHECK(event.PendingCount() == 2);
+
+	CHECK(event.Dispatch() == 2);
+	CHECK((received == std::vector<std::pair<int, int>>{ { 7, 2 }, { 3, 1 } }));
+	CHECK(event.PendingCount() == 0);
+
+	received.clear();
+	event(3, 5);
+	event.ClearPending();
+	CHECK(event.Dispatch() == 0);
+	CHECK(received.empty());
+}
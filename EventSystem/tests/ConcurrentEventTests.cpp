@@ -0,0 +1,177 @@
+#include "TestHarness.h"
+#include "ConcurrentEvent.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace Events;
+
+namespace
+{
+	int destroyedSnapshots = 0;
+
+	void CountDestroyed(const void*)
+	{
+		++destroyedSnapshots;
+	}
+
+	void Nothing(int) { }
+
+	ConcurrentEvent<int>* doomed = nullptr;
+	int callsAfterDestroy = 0;
+
+	void DestroyDoomed(int)
+	{
+		delete doomed;
+		doomed = nullptr;
+	}
+
+	void CountAfterDestroy(int)
+	{
+		++callsAfterDestroy;
+	}
+
+	struct Recorder
+	{
+		std::string calls;
+
+		void First(int)
+		{
+			calls += 'a';
+		}
+
+		void Second(int)
+		{
+			calls += 'b';
+		}
+	};
+}
+
+EVENTSYSTEM_TEST(ConcurrentEventKeepsPriorityOrder)
+{
+	ConcurrentEvent<int> event;
+	Recorder recorder;
+	event.Bind(&Recorder::Second, recorder);
+	const ListenerHandle first = event.Bind(&Recorder::First, recorder, 1);
+
+	event(0);
+	event.Unbind(first);
+	event(0);
+	CHECK(recorder.calls == "abb");
+}
+
+EVENTSYSTEM_TEST(SnapshotsRetiredDuringFireWaitForTheNextChange)
+{
+	ConcurrentEvent<int> event;
+	struct Retirer
+	{
+		void OnFire(int)
+		{
+			snapshotReaders.Retire(this, &CountDestroyed);
+		}
+	} retirer;
+	const ListenerHandle handle = event.Bind(&Retirer::OnFire, retirer);
+
+	destroyedSnapshots = 0;
+	event(0);
+	//Ending the fire must not wait for anyone, so nothing is freed yet.
+	CHECK(destroyedSnapshots == 0);
+	event.Unbind(handle);
+	CHECK(destroyedSnapshots == 1);
+}
+
+EVENTSYSTEM_TEST(EndingAFireNeverWaitsForOtherReaders)
+{
+	//A retires a snapshot of first from inside its fire, then waits on a mutex held by B while B fires second.
+	//B's fire must end without waiting for A to leave first.
+	ConcurrentEvent<int> first;
+	ConcurrentEvent<int> second;
+	std::mutex held;
+	std::atomic<bool> retired{ false };
+	std::atomic<bool> holding{ false };
+
+	struct Blocker
+	{
+		ConcurrentEvent<int>& event;
+		std::mutex& held;
+		std::atomic<bool>& retired;
+
+		void OnFire(int)
+		{
+			event.Bind(&Nothing);
+			retired = true;
+			std::lock_guard<std::mutex> lock(held);
+		}
+	} blocker{ first, held, retired };
+	first.Bind(&Blocker::OnFire, blocker);
+	second.Bind(&Nothing);
+
+	std::thread b([&]
+		{
+			std::lock_guard<std::mutex> lock(held);
+			holding = true;
+			while (!retired)
+			{
+				std::this_thread::yield();
+			}
+			second(0);
+		});
+	while (!holding)
+	{
+		std::this_thread::yield();
+	}
+	first(0);
+	b.join();
+	CHECK(retired.load());
+	snapshotReaders.Reclaim();
+}
+
+EVENTSYSTEM_TEST(ConcurrentEventDestroyedByItsOwnFunction)
+{
+	doomed = new ConcurrentEvent<int>();
+	doomed->Bind(&DestroyDoomed, 1);
+	doomed->Bind(&CountAfterDestroy);
+	(*doomed)(0);
+	CHECK(doomed == nullptr);
+	CHECK(callsAfterDestroy == 1);
+	snapshotReaders.Reclaim();
+}
+
+EVENTSYSTEM_TEST(ConcurrentEventFiresWhileChanging)
+{
+	ConcurrentEvent<int> event;
+	std::atomic<int> calls{ 0 };
+	struct Counter
+	{
+		std::atomic<int>& calls;
+
+		void OnFire(int)
+		{
+			++calls;
+		}
+	} counter{ calls };
+	event.Bind(&Counter::OnFire, counter);
+
+	std::atomic<bool> done{ false };
+	std::thread churner([&]
+		{
+			while (!done)
+			{
+				event.Unbind(event.Bind(&Nothing));
+			}
+		});
+	std::thread readers[2];
+	for (std::thread& reader : readers)
+	{
+		reader = std::thread([&event] { for (int i = 0; i < 20000; ++i) { event(int(i)); } });
+	}
+	for (std::thread& reader : readers)
+	{
+		reader.join();
+	}
+	done = true;
+	churner.join();
+	CHECK(calls.load() == 40000);
+}
@@ -0,0 +1,45 @@
+#include "TestHarness.h"
+#include "Event.h"
+
+#include <string>
+#include <vector>
+
+using namespace Events;
+
+EVENTSYSTEM_TEST(ConsumableEventStopsAtTheFirstHandler)
+{
+	ConsumableEvent<int> event;
+	std::vector<int> called;
+	event.Bind([&called](int) { called.push_back(0); return false; }, 2);
+	event.Bind([&called](int value) { called.push_back(1); return value > 0; }, 1);
+	event.Bind([&called](int) { called.push_back(2); return true; });
+
+	CHECK(event(1));
+	CHECK((called == std::vector<int>{ 0, 1 }));
+
+	called.clear();
+	CHECK(event(0));
+	CHECK((called == std::vector<int>{ 0, 1, 2 }));
+}
+
+EVENTSYSTEM_TEST(ConsumableEventUnhandledReturnsFalse)
+{
+	ConsumableEvent<int> event;
+	CHECK(!event(1));
+
+	event.Bind([](int) { return false; });
+	CHECK(!event(1));
+}
+
+EVENTSYSTEM_TEST(ConsumableEventBroadcastKeepsTheArguments)
+{
+	ConsumableEvent<std::string> event;
+	std::vector<std::string> received;
+	event.Bind([&received](std::string value) { received.push_back(std::move(value)); return false; });
+	event.Bind([&received](std::string value) { received.push_back(std::move(value)); return true; });
+
+	const std::string message = "click";
+	CHECK(event.Broadcast(message));
+	CHECK((received == std::vector<std::string>{ "click", "click" }));
+	CHECK(message == "click");
+}
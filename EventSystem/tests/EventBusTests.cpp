@@ -0,0 +1,69 @@
+#include "TestHarness.h"
+#include "EventBus.h"
+
+#include <string>
+
+using namespace Events;
+
+namespace
+{
+	struct Damage
+	{
+		int amount;
+	};
+
+	struct Chat
+	{
+		std::string text;
+	};
+}
+
+EVENTSYSTEM_TEST(EventBusRoutesByPayloadType)
+{
+	EventBus bus;
+	int damage = 0;
+	std::string chat;
+	bus.Bind<Damage>([&damage](const Damage& payload) { damage += payload.amount; });
+	bus.Bind<Chat>([&chat](const Chat& payload) { chat += payload.text; });
+
+	bus.Publish<Damage>(Damage{ 3 });
+	bus.Publish<Damage>(4);
+	bus.Publish<Chat>(std::string("hi"));
+	CHECK(damage == 7);
+	CHECK(chat == "hi");
+}
+
+EVENTSYSTEM_TEST(EventBusPublishWithoutSubscribersDoesNothing)
+{
+	EventBus bus;
+	CHECK(!bus.HasSubscribers<Damage>());
+	bus.Publish<Damage>(1);
+	CHECK(!bus.HasSubscribers<Damage>());
+}
+
+EVENTSYSTEM_TEST(EventBusUnbindsByHandle)
+{
+	EventBus bus;
+	int calls = 0;
+	const ListenerHandle handle = bus.Bind<Damage>([&calls](const Damage&) { ++calls; });
+	CHECK(bus.HasSubscribers<Damage>());
+
+	bus.Unbind<Damage>(handle);
+	bus.Publish<Damage>(1);
+	CHECK(calls == 0);
+	CHECK(!bus.HasSubscribers<Damage>());
+}
+
+EVENTSYSTEM_TEST(EventBusSubscriptionUnbindsWhenDestroyed)
+{
+	EventBus bus;
+	int calls = 0;
+	{
+		Subscription subscription = bus.Subscribe<Damage>([&calls](const Damage&) { ++calls; });
+		bus.Publish<Damage>(1);
+		CHECK(calls == 1);
+	}
+	bus.Publish<Damage>(1);
+	CHECK(calls == 1);
+	CHECK(!bus.HasSubscribers<Damage>());
+}
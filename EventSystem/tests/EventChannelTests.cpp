@@ -0,0 +1,116 @@
+#include "TestHarness.h"
+#include "EventChannel.h"
+#include "MpscQueue.h"
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace Events;
+
+namespace
+{
+	/// Throws for every multiple of 3, after the queue claimed a slot for it.
+	struct Picky
+	{
+		std::string text;
+
+		explicit Picky(int value) : text(std::to_string(value))
+		{
+			if (value % 3 == 0)
+			{
+				throw std::runtime_error("multiple of 3");
+			}
+		}
+	};
+}
+
+EVENTSYSTEM_TEST(MpscQueueIsFifoAndBounded)
+{
+	MpscQueue<int> queue(3);
+	CHECK(queue.Capacity() == 4);
+	for (int value = 0; value < 4; ++value)
+	{
+		CHECK(queue.Emplace(value));
+	}
+	CHECK(!queue.Emplace(4));
+
+	for (int value = 0; value < 4; ++value)
+	{
+		CHECK(queue.Front() != nullptr && *queue.Front() == value);
+		queue.PopFront();
+	}
+	CHECK(queue.Front() == nullptr);
+}
+
+EVENTSYSTEM_TEST(MpscQueueSkipsValuesThatThrew)
+{
+	MpscQueue<Picky> queue(4);
+	int thrown = 0;
+	std::string popped;
+	std::string expected;
+	//Several laps, so the skipped slots have to be handed back to producers too.
+	for (int value = 1; value <= 30; ++value)
+	{
+		if (value % 3 != 0)
+		{
+			expected += std::to_string(value) + ' ';
+		}
+		try
+		{
+			CHECK(queue.Emplace(value));
+		}
+		catch (const std::runtime_error&)
+		{
+			++thrown;
+		}
+
+		while (Picky* front = queue.Front())
+		{
+			popped += front->text + ' ';
+			queue.PopFront();
+		}
+	}
+	CHECK(thrown == 10);
+	CHECK(popped == expected);
+}
+
+EVENTSYSTEM_TEST(EventChannelDeliversOnTheOwningThread)
+{
+	EventChannel<int> channel(1024);
+	const std::thread::id owner = std::this_thread::get_id();
+	long long sum = 0;
+	bool onOwner = true;
+	channel.Bind([&](int value)
+		{
+			sum += value;
+			onOwner = onOwner && std::this_thread::get_id() == owner;
+		});
+
+	std::thread producers[2];
+	for (std::thread& producer : producers)
+	{
+		producer = std::thread([&channel]
+			{
+				for (int value = 1; value <= 1000; ++value)
+				{
+					while (!channel(int(value)))
+					{
+						std::this_thread::yield();
+					}
+				}
+			});
+	}
+
+	std::size_t delivered = 0;
+	while (delivered < 2000)
+	{
+		delivered += channel.Dispatch();
+	}
+	for (std::thread& producer : producers)
+	{
+		producer.join();
+	}
+	CHECK(sum == 2 * 1000 * 1001 / 2);
+	CHECK(onOwner);
+}
@@ -0,0 +1,257 @@
+#include "TestHarness.h"
+#include "Event.h"
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace Events;
+
+static_assert(std::is_nothrow_move_constructible<Subscription>::value && std::is_nothrow_move_assignable<Subscription>::value,
+	"Subscriptions are moved around by containers that rely on it not throwing.");
+static_assert(!std::is_copy_constructible<Event<int>>::value, "Copying an event would leave its subscriptions behind.");
+
+namespace
+{
+	struct Counter : TrackedListener
+	{
+		int calls = 0;
+
+		void OnFire(int)
+		{
+			++calls;
+		}
+	};
+}
+
+EVENTSYSTEM_TEST(StaleHandleIsIgnored)
+{
+	Event<int> event;
+	int first = 0;
+	int second = 0;
+	const ListenerHandle stale = event.Bind([&first](int) { ++first; });
+	event.Unbind(stale);
+	//Reuses the slot of the first function, with a new generation.
+	const ListenerHandle fresh = event.Bind([&second](int) { ++second; });
+
+	event.Unbind(stale);
+	event.Unbind(ListenerHandle());
+	CHECK(!event.IsBound(stale));
+	CHECK(event.IsBound(fresh));
+	CHECK(event.ListenerCount() == 1);
+
+	event(1);
+	CHECK(first == 0);
+	CHECK(second == 1);
+}
+
+EVENTSYSTEM_TEST(UnbindByHandleKeepsTheOthers)
+{
+	Event<int> event;
+	std::string calls;
+	const ListenerHandle a = event.Bind([&calls](int) { calls += 'a'; });
+	const ListenerHandle b = event.Bind([&calls](int) { calls += 'b'; });
+	const ListenerHandle c = event.Bind([&calls](int) { calls += 'c'; });
+
+	event.Unbind(b);
+	event(0);
+	CHECK(calls == "ac");
+	CHECK(event.IsBound(a) && !event.IsBound(b) && event.IsBound(c));
+}
+
+EVENTSYSTEM_TEST(UnbindDuringFireSkipsRightAway)
+{
+	Event<int> event;
+	std::string calls;
+	ListenerHandle later;
+	ListenerHandle self;
+	event.Bind([&](int) { calls += 'a'; event.Unbind(later); });
+	self = event.Bind([&](int) { calls += 'b'; event.Unbind(self); });
+	later = event.Bind([&](int) { calls += 'c'; });
+
+	event(0);
+	event(0);
+	CHECK(calls == "aba");
+	CHECK(event.ListenerCount() == 1);
+}
+
+EVENTSYSTEM_TEST(BindDuringFireRunsFromNextFire)
+{
+	Event<int> event;
+	int added = 0;
+	event.Bind([&](int) { event.Bind([&added](int) { ++added; }); });
+
+	event(0);
+	CHECK(added == 0);
+	CHECK(event.ListenerCount() == 2);
+	event(0);
+	CHECK(added == 1);
+}
+
+EVENTSYSTEM_TEST(UnbindAllDuringFire)
+{
+	Event<int> event;
+	int calls = 0;
+	event.Bind([&](int) { ++calls; event.UnbindAll(); });
+	event.Bind([&calls](int) { ++calls; });
+
+	event(0);
+	event(0);
+	CHECK(calls == 1);
+	CHECK(event.ListenerCount() == 0);
+}
+
+EVENTSYSTEM_TEST(HigherPriorityRunsFirstThenBindOrder)
+{
+	Event<int> event;
+	std::string calls;
+	event.Bind([&](int) { calls += 'c'; });
+	event.Bind([&](int) { calls += 'a'; }, 5);
+	event.Bind([&](int) { calls += 'd'; }, -1);
+	event.Bind([&](int) { calls += 'b'; }, 5);
+
+	event(0);
+	CHECK(calls == "abcd");
+}
+
+EVENTSYSTEM_TEST(PriorityHoldsForFunctionsBoundDuringFire)
+{
+	Event<int> event;
+	std::string calls;
+	bool bound = false;
+	event.Bind([&](int)
+		{
+			calls += 'b';
+			if (!bound)
+			{
+				bound = true;
+				event.Bind([&calls](int) { calls += 'a'; }, 1);
+				event.Bind([&calls](int) { calls += 'c'; }, -1);
+			}
+		});
+
+	event(0);
+	calls.clear();
+	event(0);
+	CHECK(calls == "abc");
+}
+
+EVENTSYSTEM_TEST(SubscriptionUnbindsWhenDestroyed)
+{
+	Event<int> event;
+	int calls = 0;
+	{
+		Subscription subscription = event.Subscribe([&calls](int) { ++calls; });
+		event(0);
+		Subscription moved = std::move(subscription);
+		CHECK(!subscription.IsActive());
+		CHECK(moved.IsActive());
+	}
+	event(0);
+	CHECK(calls == 1);
+	CHECK(event.ListenerCount() == 0);
+
+	Subscription released = event.Subscribe([&calls](int) { ++calls; });
+	released.Release();
+	CHECK(event.ListenerCount() == 1);
+}
+
+EVENTSYSTEM_TEST(SubscriptionFollowsMovedEvent)
+{
+	std::vector<Event<int>> events(1);
+	int calls = 0;
+	Subscription subscription = events[0].Subscribe([&calls](int) { ++calls; });
+	auto counter = std::make_unique<Counter>();
+	events[0].Bind(&Counter::OnFire, *counter);
+
+	//Reallocation moves the first event, which must take its subscriptions along.
+	for (int i = 0; i < 64; ++i)
+	{
+		events.emplace_back();
+	}
+
+	events[0](0);
+	CHECK(calls == 1);
+	CHECK(counter->calls == 1);
+	CHECK(subscription.IsActive());
+
+	subscription.Reset();
+	counter.reset();
+	CHECK(events[0].ListenerCount() == 0);
+}
+
+EVENTSYSTEM_TEST(SubscriptionOutlivesEvent)
+{
+	Subscription subscription;
+	{
+		Event<int> event;
+		subscription = event.Subscribe([](int) {});
+		CHECK(subscription.IsActive());
+	}
+	CHECK(!subscription.IsActive());
+	subscription.Reset();
+}
+
+EVENTSYSTEM_TEST(TrackedListenerUnbindsEverywhere)
+{
+	std::vector<Event<int>> events(1000);
+	{
+		Counter counter;
+		for (Event<int>& event : events)
+		{
+			event.Bind(&Counter::OnFire, counter);
+		}
+		//Unbound some other way, the object must still let go of the rest.
+		for (std::size_t i = 0; i < events.size(); i += 2)
+		{
+			events[i].UnbindAll();
+		}
+		for (Event<int>& event : events)
+		{
+			event(0);
+		}
+		CHECK(counter.calls == 500);
+	}
+
+	std::size_t bound = 0;
+	for (const Event<int>& event : events)
+	{
+		bound += event.ListenerCount();
+	}
+	CHECK(bound == 0);
+}
+
+EVENTSYSTEM_TEST(ValueArgumentsAreCopiedForEveryFunctionButTheLast)
+{
+	Event<std::string> event;
+	std::string first;
+	std::string last;
+	event.Bind([&first](std::string text) { first = std::move(text); }, 1);
+	event.Bind([&last](std::string text) { last = std::move(text); });
+
+	event(std::string("payload"));
+	CHECK(first == "payload");
+	CHECK(last == "payload");
+
+	const std::string kept = "kept";
+	event.Broadcast(kept);
+	CHECK(first == "kept" && last == "kept");
+}
+
+EVENTSYSTEM_TEST(MoveOnlyArgumentsReachTheirFunction)
+{
+	Event<std::unique_ptr<int>> event;
+	std::unique_ptr<int> received;
+	event.Bind([&received](std::unique_ptr<int> value) { received = std::move(value); });
+
+	event(std::make_unique<int>(7));
+	CHECK(received != nullptr && *received == 7);
+
+	//Every function sees the same object, the first one that doesn't move from it leaves it for the next.
+	int seen = 0;
+	event.Bind([&seen](std::unique_ptr<int>&& value) { seen = *value; }, 1);
+	event(std::make_unique<int>(8));
+	CHECK(seen == 8);
+	CHECK(*received == 8);
+}
@@ -0,0 +1,88 @@
+#include "TestHarness.h"
+#include "FixedEvent.h"
+
+#include <new>
+
+using namespace Events;
+
+namespace
+{
+	int calls = 0;
+
+	void Count(int)
+	{
+		++calls;
+	}
+}
+
+EVENTSYSTEM_TEST(FixedEventChurnsWhileFull)
+{
+	FixedEvent<64, int> event;
+	ListenerHandle handles[64];
+	for (ListenerHandle& handle : handles)
+	{
+		handle = event.Bind(&Count);
+	}
+
+	//Never grows past its buffer, which would throw.
+	for (int i = 0; i < 10000; ++i)
+	{
+		ListenerHandle& handle = handles[(i * 37) % 64];
+		event.Unbind(handle);
+		handle = event.Bind(&Count);
+	}
+
+	calls = 0;
+	event(0);
+	CHECK(calls == 64);
+	CHECK(event.ListenerCount() == 64);
+}
+
+EVENTSYSTEM_TEST(FixedEventThrowsPastItsCapacity)
+{
+	FixedEvent<4, int> event;
+	for (int i = 0; i < 4; ++i)
+	{
+		event.Bind(&Count);
+	}
+
+	bool thrown = false;
+	try
+	{
+		for (int i = 0; i < 64; ++i)
+		{
+			event.Bind(&Count);
+		}
+	}
+	catch (const std::bad_alloc&)
+	{
+		thrown = true;
+	}
+	CHECK(thrown);
+}
+
+EVENTSYSTEM_TEST(ReservedEventChurnsWithoutCompactingEveryBind)
+{
+	Event<int> event;
+	event.Reserve(256);
+	ListenerHandle handles[256];
+	for (ListenerHandle& handle : handles)
+	{
+		handle = event.Bind(&Count);
+	}
+
+	for (int i = 0; i < 10000; ++i)
+	{
+		ListenerHandle& handle = handles[(i * 101) % 256];
+		event.Unbind(handle);
+		handle = event.Bind(&Count);
+	}
+
+	calls = 0;
+	event(0);
+	CHECK(calls == 256);
+	for (const ListenerHandle& handle : handles)
+	{
+		CHECK(event.IsBound(handle));
+	}
+}
@@ -0,0 +1,125 @@
+#include "TestHarness.h"
+#include "GroupedEvent.h"
+
+#include <vector>
+
+using namespace Events;
+
+namespace
+{
+	std::vector<int> calls;
+
+	struct Enemy
+	{
+		int id;
+
+		void OnExplosion(int damage)
+		{
+			calls.push_back(id * 100 + damage);
+		}
+
+		void OnAlarm(int)
+		{
+			calls.push_back(-id);
+		}
+	};
+
+	std::vector<std::size_t> batchCounts;
+
+	void OnExplosionBatch(CallerSpan<Enemy*> enemies, int)
+	{
+		std::size_t alive = 0;
+		for (Enemy* enemy : enemies)
+		{
+			alive += enemy != nullptr ? 1 : 0;
+		}
+		batchCounts.push_back(alive);
+	}
+}
+
+EVENTSYSTEM_TEST(GroupedEventCallsGroupsInFirstBindOrder)
+{
+	GroupedEvent<int> event;
+	Enemy first{ 1 }, second{ 2 };
+	event.Bind<&Enemy::OnAlarm>(first);
+	event.Bind<&Enemy::OnExplosion>(first);
+	event.Bind<&Enemy::OnExplosion>(second);
+	event.Bind<&Enemy::OnAlarm>(second);
+	CHECK(event.GroupCount() == 2);
+	CHECK(event.ListenerCount() == 4);
+
+	calls.clear();
+	event(5);
+	CHECK((calls == std::vector<int>{ -1, -2, 105, 205 }));
+}
+
+EVENTSYSTEM_TEST(GroupedEventUnbindKeepsTheOrderOfTheRest)
+{
+	GroupedEvent<int> event;
+	Enemy enemies[4] = { { 1 }, { 2 }, { 3 }, { 4 } };
+	ListenerHandle handles[4];
+	for (int i = 0; i < 4; ++i)
+	{
+		handles[i] = event.Bind<&Enemy::OnExplosion>(enemies[i]);
+	}
+
+	event.Unbind(handles[1]);
+	event.Unbind(handles[1]);
+	CHECK(!event.IsBound(handles[1]));
+	CHECK(event.ListenerCount() == 3);
+
+	calls.clear();
+	event(0);
+	CHECK((calls == std::vector<int>{ 100, 300, 400 }));
+}
+
+EVENTSYSTEM_TEST(GroupedEventChangesDuringFireApplyFromTheNextOne)
+{
+	GroupedEvent<int> event;
+	Enemy first{ 1 }, second{ 2 }, late{ 3 };
+	ListenerHandle secondHandle;
+
+	struct Binder
+	{
+		GroupedEvent<int>* event;
+		Enemy* late;
+		ListenerHandle* unbind;
+
+		void OnExplosion(int)
+		{
+			event->Unbind(*unbind);
+			event->Bind<&Enemy::OnExplosion>(*late);
+		}
+	} binder{ &event, &late, &secondHandle };
+
+	event.Bind<&Binder::OnExplosion>(binder);
+	event.Bind<&Enemy::OnExplosion>(first);
+	secondHandle = event.Bind<&Enemy::OnExplosion>(second);
+
+	calls.clear();
+	event(0);
+	CHECK((calls == std::vector<int>{ 100 }));
+
+	event.UnbindAll();
+	event.Bind<&Enemy::OnExplosion>(late);
+	calls.clear();
+	event(0);
+	CHECK((calls == std::vector<int>{ 300 }));
+}
+
+EVENTSYSTEM_TEST(GroupedEventBatchHandlerGetsTheWholeGroup)
+{
+	GroupedEvent<int> event;
+	Enemy enemies[3] = { { 1 }, { 2 }, { 3 } };
+	ListenerHandle handles[3];
+	for (int i = 0; i < 3; ++i)
+	{
+		handles[i] = event.BindBatch<&OnExplosionBatch>(enemies[i]);
+	}
+
+	batchCounts.clear();
+	event(0);
+	event.Unbind(handles[0]);
+	event(0);
+	CHECK((batchCounts == std::vector<std::size_t>{ 3, 2 }));
+}
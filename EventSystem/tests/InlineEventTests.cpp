@@ -0,0 +1,61 @@
+#include "TestHarness.h"
+#include "InlineEvent.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace Events;
+
+namespace
+{
+	/// Remembers where the event stored it, which is where a fire reads it from.
+	struct AddressRecorder
+	{
+		const void** address;
+
+		void operator() (int) const
+		{
+			*address = this;
+		}
+	};
+
+	std::uintptr_t Address(const void* pointer)
+	{
+		return reinterpret_cast<std::uintptr_t>(pointer);
+	}
+}
+
+EVENTSYSTEM_TEST(InlineEventFiresFromTwoCacheLines)
+{
+	static_assert(alignof(InlineEvent<1, int>) == CacheLineSize, "An InlineEvent always starts a cache line.");
+
+	InlineEvent<1, int> event;
+	const void* stored = nullptr;
+	event.Bind(AddressRecorder{ &stored });
+	event(0);
+
+	//The function fills the first line, and the bound functions and fire depth start the second one.
+	const std::uintptr_t start = Address(&event);
+	CHECK(start % CacheLineSize == 0);
+	CHECK(stored != nullptr && Address(stored) - start < CacheLineSize);
+	CHECK(Address(static_cast<Event<int>*>(&event)) % CacheLineSize == 0);
+}
+
+EVENTSYSTEM_TEST(InlineEventMovesPastItsInlineCount)
+{
+	InlineEvent<2, int> event;
+	std::vector<int> order;
+	for (int i = 0; i < 5; ++i)
+	{
+		event.Bind([&order, i](int) { order.push_back(i); });
+	}
+
+	event(0);
+	CHECK((order == std::vector<int>{ 0, 1, 2, 3, 4 }));
+
+	event.UnbindAll();
+	order.clear();
+	event.Bind([&order](int value) { order.push_back(value); });
+	event(7);
+	CHECK((order == std::vector<int>{ 7 }));
+}
@@ -0,0 +1,101 @@
+#include "TestHarness.h"
+#include "KeyedEvent.h"
+
+#include <memory>
+#include <string>
+
+using namespace Events;
+
+namespace
+{
+	struct Entity : TrackedListener
+	{
+		int hits = 0;
+
+		void OnDamage(int, int amount)
+		{
+			hits += amount;
+		}
+	};
+}
+
+EVENTSYSTEM_TEST(KeyedEventOnlyCallsFunctionsOfTheKey)
+{
+	KeyedEvent<int, int> event;
+	std::string calls;
+	event.BindKeyed(1, [&calls](int, int) { calls += 'a'; });
+	event.BindKeyed(2, [&calls](int, int) { calls += 'b'; });
+	event.Bind([&calls](int, int) { calls += '*'; });
+
+	event(1, 0);
+	event(3, 0);
+	CHECK(calls == "a**");
+	CHECK(event.KeyCount() == 2);
+	CHECK(event.ListenerCount() == 3);
+}
+
+EVENTSYSTEM_TEST(KeyedEventDropsKeyUnboundDuringItsFire)
+{
+	KeyedEvent<int, int> event;
+	ListenerHandle self;
+	self = event.BindKeyed(7, [&](int key, int) { event.Unbind(key, self); });
+
+	event(7, 0);
+	CHECK(event.KeyCount() == 0);
+	CHECK(event.ListenerCount() == 0);
+}
+
+EVENTSYSTEM_TEST(KeyedEventDropsKeyOfDestroyedTrackedListener)
+{
+	KeyedEvent<int, int> event;
+	{
+		Entity entity;
+		event.BindKeyed(1, &Entity::OnDamage, entity);
+		event(1, 3);
+		CHECK(entity.hits == 3);
+		CHECK(event.KeyCount() == 1);
+	}
+	CHECK(event.KeyCount() == 0);
+
+	//Same, with the object destroyed while its key fires, by a function bound to every key.
+	auto entity = std::make_unique<Entity>();
+	event.BindKeyed(2, &Entity::OnDamage, *entity);
+	event.Bind([&entity](int, int) { entity.reset(); });
+	event(2, 1);
+	CHECK(entity == nullptr);
+	CHECK(event.KeyCount() == 0);
+	CHECK(event.ListenerCount() == 1);
+}
+
+EVENTSYSTEM_TEST(KeyedEventDropsKeysOfSubscriptions)
+{
+	KeyedEvent<int, int> event;
+	int calls = 0;
+	event.BindKeyed(4, [](int, int) {});
+	Subscription subscription = event.Find(4)->Subscribe([&calls](int, int) { ++calls; });
+	event.UnbindAll();
+	CHECK(event.KeyCount() == 0);
+	CHECK(!subscription.IsActive());
+
+	const ListenerHandle handle = event.BindKeyed(5, [](int, int) {});
+	subscription = event.Find(5)->Subscribe([&calls](int, int) { ++calls; });
+	event.Unbind(5, handle);
+	event(5, 0);
+	CHECK(calls == 1);
+	subscription.Reset();
+	CHECK(event.KeyCount() == 0);
+}
+
+EVENTSYSTEM_TEST(KeyedEventUnbindAllDuringFire)
+{
+	KeyedEvent<int, int> event;
+	int other = 0;
+	event.BindKeyed(1, [&event](int, int) { event.UnbindAll(); });
+	event.BindKeyed(2, [&other](int, int) { ++other; });
+	event.Bind([&other](int, int) { ++other; });
+
+	event(1, 0);
+	CHECK(other == 0);
+	CHECK(event.KeyCount() == 0);
+	CHECK(event.ListenerCount() == 0);
+}
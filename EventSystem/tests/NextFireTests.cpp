@@ -0,0 +1,152 @@
+#include "TestHarness.h"
+#include "Event.h"
+
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace Events;
+
+namespace
+{
+	///<summary>
+	///Stands in for a suspended coroutine, so the awaitable can be driven without C++20: the frame is this object, and
+	///resuming it takes the value out of the awaitable, the way the code after co_await would.
+	///</summary>
+	template<typename ...Args>
+	struct FakeCoroutine
+	{
+		using ResumeType = decltype(std::declval<NextFire<Args...>&>().await_resume());
+
+		NextFire<Args...> awaiter;
+		/// What every resume got, or just true for events without arguments.
+		std::vector<std::conditional_t<std::is_void<ResumeType>::value, bool, ResumeType>> resumedWith;
+		/// Waits for the next fire again right away, like a coroutine awaiting in a loop.
+		bool waitAgain = false;
+
+		explicit FakeCoroutine(Event<Args...>& event) : awaiter(event) { }
+
+		void Suspend();
+
+		void Resume()
+		{
+			if constexpr (std::is_void<ResumeType>::value)
+			{
+				awaiter.await_resume();
+				resumedWith.push_back(true);
+			}
+			else
+			{
+				resumedWith.push_back(awaiter.await_resume());
+			}
+			if (waitAgain)
+			{
+				Suspend();
+			}
+		}
+	};
+
+	template<typename ...Args>
+	struct FakeHandle
+	{
+		FakeCoroutine<Args...>* frame;
+
+		void* address() const
+		{
+			return frame;
+		}
+
+		static FakeHandle from_address(void* address)
+		{
+			return { static_cast<FakeCoroutine<Args...>*>(address) };
+		}
+
+		void resume() const
+		{
+			frame->Resume();
+		}
+	};
+
+	template<typename ...Args>
+	void FakeCoroutine<Args...>::Suspend()
+	{
+		CHECK(!awaiter.await_ready());
+		awaiter.await_suspend(FakeHandle<Args...>{ this });
+	}
+}
+
+EVENTSYSTEM_TEST(NextFireResumesAfterEveryFunction)
+{
+	Event<int> event;
+	FakeCoroutine<int> coroutine(event);
+	std::vector<int> order;
+	event.Bind([&](int value)
+		{
+			order.push_back(value);
+			CHECK(coroutine.resumedWith.size() == order.size() - 1);
+		});
+
+	coroutine.Suspend();
+	event(5);
+	CHECK((order == std::vector<int>{ 5 }));
+	CHECK((coroutine.resumedWith == std::vector<int>{ 5 }));
+
+	//Resumed once, later fires no longer reach it.
+	event(6);
+	CHECK((coroutine.resumedWith == std::vector<int>{ 5 }));
+	CHECK((order == std::vector<int>{ 5, 6 }));
+}
+
+EVENTSYSTEM_TEST(NextFireWaitingAgainIsOnlyResumedByTheNextFire)
+{
+	Event<std::string> event;
+	FakeCoroutine<std::string> coroutine(event);
+	coroutine.waitAgain = true;
+	coroutine.Suspend();
+
+	const std::string first = "first";
+	event.Broadcast(first);
+	CHECK((coroutine.resumedWith == std::vector<std::string>{ "first" }));
+	event(std::string("second"));
+	CHECK((coroutine.resumedWith == std::vector<std::string>{ "first", "second" }));
+}
+
+EVENTSYSTEM_TEST(NextFireDestroyedWhileWaitingIsNeverResumed)
+{
+	Event<int> event;
+	int calls = 0;
+	event.Bind([&calls](int) { ++calls; });
+	{
+		FakeCoroutine<int> coroutine(event);
+		coroutine.Suspend();
+	}
+
+	event(1);
+	event(2);
+	CHECK(calls == 2);
+
+	FakeCoroutine<int> coroutine(event);
+	coroutine.Suspend();
+	event(3);
+	CHECK((coroutine.resumedWith == std::vector<int>{ 3 }));
+}
+
+EVENTSYSTEM_TEST(NextFireResumesWithEveryArgument)
+{
+	Event<int, std::string> pair;
+	FakeCoroutine<int, std::string> both(pair);
+	both.Suspend();
+	pair(1, std::string("one"));
+	CHECK(both.resumedWith.size() == 1 && both.resumedWith[0] == std::make_tuple(1, std::string("one")));
+
+	Event<> signal;
+	FakeCoroutine<> none(signal);
+	bool resumed = false;
+	signal.Bind([&resumed] { resumed = true; });
+	none.Suspend();
+	signal();
+	CHECK(resumed);
+	CHECK(none.resumedWith.size() == 1);
+}
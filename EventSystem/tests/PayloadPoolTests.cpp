@@ -0,0 +1,93 @@
+#include "TestHarness.h"
+#include "Event.h"
+#include "PayloadPool.h"
+#include "QueuedEvent.h"
+
+#include <thread>
+#include <vector>
+
+using namespace Events;
+
+EVENTSYSTEM_TEST(PayloadPoolHandsOutEveryValueOnce)
+{
+	PayloadPool<int> pool(2);
+	PooledPayload<int> first = pool.Acquire();
+	PooledPayload<int> second = pool.Acquire();
+	CHECK(first && second);
+	CHECK(first.Get() != second.Get());
+	CHECK(!pool.Acquire());
+	CHECK(pool.FreeCount() == 0);
+
+	first.Reset();
+	CHECK(!first);
+	CHECK(pool.FreeCount() == 1);
+	CHECK(pool.Acquire());
+}
+
+EVENTSYSTEM_TEST(PayloadPoolReturnsTheValueWithTheLastCopy)
+{
+	PayloadPool<std::vector<int>> pool(1, std::vector<int>());
+	{
+		PooledPayload<std::vector<int>> payload = pool.Acquire();
+		payload->reserve(64);
+		payload->push_back(1);
+		PooledPayload<std::vector<int>> copy = payload;
+		payload.Reset();
+		CHECK(pool.FreeCount() == 0);
+		CHECK(copy->size() == 1);
+	}
+	CHECK(pool.FreeCount() == 1);
+
+	//Values come back the way their last user left them.
+	PooledPayload<std::vector<int>> reused = pool.Acquire();
+	CHECK(reused->capacity() >= 64);
+}
+
+EVENTSYSTEM_TEST(PooledPayloadIsSharedByEveryListener)
+{
+	PayloadPool<int> pool(4);
+	QueuedEvent<const PooledPayload<int>&> event(4);
+	std::vector<const int*> received;
+	for (int i = 0; i < 3; ++i)
+	{
+		event.Bind([&received](const PooledPayload<int>& payload) { received.push_back(payload.Get()); });
+	}
+
+	{
+		PooledPayload<int> payload = pool.Acquire();
+		*payload = 42;
+		event(payload);
+	}
+	CHECK(pool.FreeCount() == 3);
+
+	event.Dispatch();
+	CHECK(received.size() == 3 && received[0] == received[1] && received[1] == received[2]);
+	CHECK(*received[0] == 42);
+	CHECK(pool.FreeCount() == 4);
+}
+
+EVENTSYSTEM_TEST(PayloadPoolIsSharedAcrossThreads)
+{
+	PayloadPool<int> pool(8);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t)
+	{
+		threads.emplace_back([&pool]
+			{
+				for (int i = 0; i < 10000; ++i)
+				{
+					PooledPayload<int> payload = pool.Acquire();
+					if (payload)
+					{
+						PooledPayload<int> copy = payload;
+						*copy = i;
+					}
+				}
+			});
+	}
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	CHECK(pool.FreeCount() == 8);
+}
@@ -0,0 +1,97 @@
+#include "TestHarness.h"
+#include "CoalescingEvent.h"
+#include "EventChannel.h"
+#include "QueuedEvent.h"
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace Events;
+
+//Firing through an Event reference would call the functions right away, skipping the queue.
+static_assert(!std::is_convertible<QueuedEvent<int>*, Event<int>*>::value, "A QueuedEvent must not be usable as an Event.");
+static_assert(!std::is_convertible<EventChannel<int>*, Event<int>*>::value, "An EventChannel must not be usable as an Event.");
+static_assert(!std::is_convertible<CoalescingEvent<int>*, Event<int>*>::value, "A CoalescingEvent must not be usable as an Event.");
+static_assert(!std::is_convertible<KeyedCoalescingEvent<int, int>*, Event<int, int>*>::value,
+	"A KeyedCoalescingEvent must not be usable as an Event.");
+
+EVENTSYSTEM_TEST(QueuedEventOnlyCallsOnDispatch)
+{
+	QueuedEvent<int> event(8);
+	std::vector<int> received;
+	event.Bind([&received](int value) { received.push_back(value); });
+
+	CHECK(event(1));
+	CHECK(event(2));
+	CHECK(received.empty());
+	CHECK(event.PendingCount() == 2);
+
+	CHECK(event.Dispatch() == 2);
+	CHECK((received == std::vector<int>{ 1, 2 }));
+	CHECK(event.PendingCount() == 0);
+}
+
+EVENTSYSTEM_TEST(QueuedEventDropsWhenFull)
+{
+	QueuedEvent<int> event(2);
+	int calls = 0;
+	event.Bind([&calls](int) { ++calls; });
+
+	CHECK(event(1));
+	CHECK(event(2));
+	CHECK(!event(3));
+	CHECK(event.Drain(1) == 1);
+	CHECK(calls == 1);
+	CHECK(event(4));
+	CHECK(event.Dispatch() == 2);
+	CHECK(calls == 3);
+}
+
+EVENTSYSTEM_TEST(QueuedEventDeliversItsOwnCopy)
+{
+	QueuedEvent<const std::string&> event(4);
+	std::string received;
+	event.Bind([&received](const std::string& value) { received = value; });
+
+	{
+		std::string message = "queued";
+		event(message);
+	}
+	event.Dispatch();
+	CHECK(received == "queued");
+}
+
+EVENTSYSTEM_TEST(QueuedEventFiredDuringDispatchWaitsForTheNextOne)
+{
+	QueuedEvent<int> event(8);
+	std::vector<int> received;
+	event.Bind([&](int value)
+		{
+			received.push_back(value);
+			if (value == 1)
+			{
+				event(2);
+			}
+		});
+
+	event(1);
+	CHECK(event.Dispatch() == 1);
+	CHECK((received == std::vector<int>{ 1 }));
+	CHECK(event.Dispatch() == 1);
+	CHECK((received == std::vector<int>{ 1, 2 }));
+}
+
+EVENTSYSTEM_TEST(QueuedEventSubscriptionUnbinds)
+{
+	QueuedEvent<int> event(4);
+	int calls = 0;
+	{
+		Subscription subscription = event.Subscribe([&calls](int) { ++calls; });
+		CHECK(event.ListenerCount() == 1);
+	}
+	CHECK(event.ListenerCount() == 0);
+	event(1);
+	event.Dispatch();
+	CHECK(calls == 0);
+}
@@ -0,0 +1,73 @@
+#include "TestHarness.h"
+#include "EventRecorder.h"
+
+#include <cstdio>
+
+using namespace Events;
+
+namespace
+{
+	struct Blob
+	{
+		unsigned char bytes[256];
+	};
+}
+
+EVENTSYSTEM_TEST(RecorderRejectsFiresBiggerThanAChunk)
+{
+	const char* path = "eventsystem_tests_recorder.log";
+	Event<const Blob&> big;
+	Event<int> small;
+	int replayed = 0;
+	{
+		EventRecorder recorder(path, 64);
+		CHECK(recorder.IsOpen());
+		CHECK(!recorder.CanRecord<const Blob&>());
+		CHECK(recorder.CanRecord<int>());
+
+		Subscription rejected = recorder.Record(big, 1);
+		Subscription recorded = recorder.Record(small, 2);
+		CHECK(!rejected.IsActive());
+		CHECK(recorded.IsActive());
+
+		const Blob blob{};
+		//More records than fit in a single chunk.
+		for (int i = 0; i < 20; ++i)
+		{
+			big(blob);
+			small(int(i));
+		}
+		recorder.Flush();
+		CHECK(recorder.RecordCount() == 20);
+	}
+
+	{
+		EventPlayer player(path);
+		Event<int> target;
+		target.Bind([&replayed](int value) { replayed += value; });
+		player.Attach(2, target);
+		CHECK(player.RecordCount() == 20);
+		CHECK(player.Play() == 20);
+	}
+	CHECK(replayed == 19 * 20 / 2);
+	std::remove(path);
+}
+
+EVENTSYSTEM_TEST(RecorderKeepsChunksBigEnoughForAHeader)
+{
+	const char* path = "eventsystem_tests_tiny.log";
+	{
+		EventRecorder recorder(path, 0);
+		Event<> event;
+		Subscription subscription = recorder.Record(event, 1);
+		CHECK(subscription.IsActive());
+		event();
+		event();
+	}
+
+	{
+		EventPlayer player(path);
+		CHECK(player.RecordCount() == 2);
+	}
+	std::remove(path);
+}
@@ -0,0 +1,78 @@
+#include "TestHarness.h"
+#include "ReducingEvent.h"
+
+#include <limits>
+
+using namespace Events;
+
+namespace
+{
+	/// Reducer with state of its own, to check the event folds results with the instance it was given.
+	struct Weighted
+	{
+		using ResultType = int;
+
+		int weight;
+
+		int Initial() const
+		{
+			return 0;
+		}
+
+		void operator()(int& total, int value) const
+		{
+			total += weight * value;
+		}
+	};
+}
+
+EVENTSYSTEM_TEST(ReducingEventFoldsEveryResult)
+{
+	ReducingEvent<Sum<int>, int> sum;
+	ReducingEvent<Max<int>, int> max;
+	ReducingEvent<Min<int>, int> min;
+	for (int i = 1; i <= 3; ++i)
+	{
+		sum.Bind([i](int value) { return value * i; });
+		max.Bind([i](int value) { return value - i; });
+		min.Bind([i](int value) { return value - i; });
+	}
+
+	CHECK(sum(2) == 12);
+	CHECK(max(10) == 9);
+	CHECK(min(10) == 7);
+}
+
+EVENTSYSTEM_TEST(ReducingEventWithoutFunctionsReturnsTheInitialResult)
+{
+	CHECK(ReducingEvent<Sum<int>, int>()(1) == 0);
+	CHECK(ReducingEvent<Any, int>()(1) == false);
+	CHECK(ReducingEvent<All, int>()(1) == true);
+	CHECK(ReducingEvent<Min<int>>()() == std::numeric_limits<int>::max());
+}
+
+EVENTSYSTEM_TEST(ReducingEventAnyAndAll)
+{
+	ReducingEvent<Any, int> any;
+	ReducingEvent<All, int> all;
+	any.Bind([](int value) { return value > 5; });
+	any.Bind([](int value) { return value > 0; });
+	all.Bind([](int value) { return value > 5; });
+	all.Bind([](int value) { return value > 0; });
+
+	CHECK(any(1));
+	CHECK(!all(1));
+	CHECK(all(6));
+	CHECK(!any(-1));
+}
+
+EVENTSYSTEM_TEST(ReducingEventUsesItsReducer)
+{
+	ReducingEvent<Weighted, int> event(Weighted{ 10 });
+	event.Bind([](int value) { return value; });
+	event.Bind([](int value) { return value + 1; });
+
+	CHECK(event(1) == 30);
+	CHECK(event.Broadcast(2) == 50);
+	CHECK(event.GetReducer().weight == 10);
+}
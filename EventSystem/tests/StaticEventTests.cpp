@@ -0,0 +1,61 @@
+#include "TestHarness.h"
+#include "StaticEvent.h"
+
+#include <string>
+#include <vector>
+
+using namespace Events;
+
+namespace
+{
+	std::vector<std::string> calls;
+
+	void OnGlobal(std::string value)
+	{
+		calls.push_back("global " + value);
+	}
+
+	struct Player
+	{
+		std::string name;
+
+		void OnHit(std::string value)
+		{
+			calls.push_back(name + " " + value);
+		}
+
+		void OnConstHit(std::string value) const
+		{
+			calls.push_back(name + " const " + value);
+		}
+	};
+}
+
+EVENTSYSTEM_TEST(StaticEventCallsEveryFunctionInOrder)
+{
+	Player first{ "first" };
+	const Player second{ "second" };
+	StaticEvent<&OnGlobal, &Player::OnHit, &Player::OnConstHit> event(first, second);
+	static_assert(decltype(event)::Size() == 3, "Every function given counts.");
+
+	calls.clear();
+	event(std::string("hit"));
+	CHECK((calls == std::vector<std::string>{ "global hit", "first hit", "second const hit" }));
+}
+
+EVENTSYSTEM_TEST(StaticEventCopiesValueArgumentsForAllButTheLast)
+{
+	Player player{ "player" };
+	StaticEvent<&Player::OnHit, &Player::OnHit> event(player, player);
+
+	//The arguments only reach the last function as is, the first one must not be able to move from them.
+	calls.clear();
+	event(std::string("a long enough string to live on the heap"));
+	CHECK(calls.size() == 2 && calls[0] == calls[1]);
+
+	calls.clear();
+	const std::string value = "kept";
+	event.Broadcast(value);
+	CHECK((calls == std::vector<std::string>{ "player kept", "player kept" }));
+	CHECK(value == "kept");
+}
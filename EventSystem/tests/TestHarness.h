@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdio>
+#include <vector>
+
+//Just enough of a test framework for eventsystem_tests, so the tests build anywhere the library does, dependency free.
+
+namespace EventsTests
+{
+	struct TestCase
+	{
+		const char* name;
+		void(*run)();
+	};
+
+	inline std::vector<TestCase>& AllTests()
+	{
+		static std::vector<TestCase> tests;
+		return tests;
+	}
+
+	/// Failed checks of the whole run.
+	inline int& FailureCount()
+	{
+		static int count = 0;
+		return count;
+	}
+
+	/// Adds a test to AllTests during static initialization, see EVENTSYSTEM_TEST.
+	struct Registrar
+	{
+		Registrar(const char* name, void(*run)())
+		{
+			AllTests().push_back({ name, run });
+		}
+	};
+
+	inline void ReportFailure(const char* file, int line, const char* expression)
+	{
+		std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+		++FailureCount();
+	}
+}
+
+/// Defines a test function, run by eventsystem_tests along with every other one.
+#define EVENTSYSTEM_TEST(name) \
+	static void name(); \
+	static const EventsTests::Registrar name##Registrar(#name, &name); \
+	static void name()
+
+/// Records a failure, and keeps going, if the given condition is false.
+#define CHECK(...) ((__VA_ARGS__) ? void() : EventsTests::ReportFailure(__FILE__, __LINE__, #__VA_ARGS__))
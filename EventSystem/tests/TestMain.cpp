@@ -0,0 +1,25 @@
+#include "TestHarness.h"
+
+#include <cstring>
+
+//Runs every test, or only the ones whose name contains the first argument, and exits with 1 if any check failed.
+int main(int argc, char** argv)
+{
+	const char* filter = argc > 1 ? argv[1] : "";
+	int run = 0;
+	for (const EventsTests::TestCase& test : EventsTests::AllTests())
+	{
+		if (std::strstr(test.name, filter) == nullptr)
+		{
+			continue;
+		}
+
+		const int failuresBefore = EventsTests::FailureCount();
+		test.run();
+		++run;
+		std::printf("%s %s\n", EventsTests::FailureCount() == failuresBefore ? "[  OK  ]" : "[ FAIL ]", test.name);
+	}
+
+	std::printf("%d tests, %d failed checks\n", run, EventsTests::FailureCount());
+	return EventsTests::FailureCount() == 0 && run > 0 ? 0 : 1;
+}
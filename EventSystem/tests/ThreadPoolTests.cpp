@@ -0,0 +1,75 @@
+#include "TestHarness.h"
+#include "Event.h"
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace Events;
+
+EVENTSYSTEM_TEST(ParallelForCoversEveryIndexOnce)
+{
+	ThreadPool pool(2);
+	std::vector<std::atomic<int>> visits(1000);
+	pool.ParallelFor(visits.size(), 7, [&visits](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				++visits[i];
+			}
+		});
+
+	bool once = true;
+	for (const std::atomic<int>& count : visits)
+	{
+		once = once && count.load() == 1;
+	}
+	CHECK(once);
+}
+
+EVENTSYSTEM_TEST(FireParallelCallsEveryFunction)
+{
+	ThreadPool pool(2);
+	Event<int> event;
+	std::atomic<int> sum{ 0 };
+	for (int i = 0; i < 256; ++i)
+	{
+		event.Bind([&sum](int value) { sum += value; });
+	}
+
+	event.FireParallel(pool, 16, 2);
+	CHECK(sum.load() == 512);
+}
+
+EVENTSYSTEM_TEST(ThreadPoolRethrowsOnCallingThread)
+{
+	ThreadPool pool(2);
+	for (int round = 0; round < 50; ++round)
+	{
+		std::atomic<int> chunks{ 0 };
+		bool caught = false;
+		try
+		{
+			pool.ParallelFor(1000, 10, [&chunks](std::size_t begin, std::size_t)
+				{
+					++chunks;
+					if (begin == 500)
+					{
+						throw std::runtime_error("chunk failed");
+					}
+				});
+		}
+		catch (const std::runtime_error&)
+		{
+			caught = true;
+		}
+		CHECK(caught);
+		CHECK(chunks.load() <= 100);
+
+		//The pool is still usable afterwards.
+		std::atomic<std::size_t> covered{ 0 };
+		pool.ParallelFor(1000, 10, [&covered](std::size_t begin, std::size_t end) { covered += end - begin; });
+		CHECK(covered.load() == 1000);
+	}
+}